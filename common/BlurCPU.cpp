@@ -0,0 +1,150 @@
+﻿#include "BlurCPU.hpp"
+#include <opencv2/core/hal/intrin.hpp>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace {
+
+// Columns handled per task in the vertical pass
+const int kColumnStrip = 512;
+
+// 16.16 fixed-point reciprocal of the window size
+inline int windowScale(int radius) {
+    int window = 2 * radius + 1;
+    return ((1 << 16) + window / 2) / window;
+}
+
+// Horizontal running sum: each output pixel adds the entering sample and
+// subtracts the leaving one, independent of the radius. This pass is scalar:
+// the sum is carried along the row, and the interleaved channels leave
+// nothing to vectorize within a pixel. Rows run in parallel instead.
+void boxBlurRows(const cv::Mat& src, cv::Mat& dst, int radius) {
+    const int width = src.cols;
+    const int channels = src.channels();
+    const int scale = windowScale(radius);
+
+    cv::parallel_for_(cv::Range(0, src.rows), [&](const cv::Range& range) {
+        for (int y = range.start; y < range.end; y++) {
+            const uchar* in = src.ptr<uchar>(y);
+            uchar* out = dst.ptr<uchar>(y);
+
+            for (int c = 0; c < channels; c++) {
+                int sum = (radius + 1) * in[c];
+                for (int i = 1; i <= radius; i++) {
+                    sum += in[std::min(i, width - 1) * channels + c];
+                }
+                for (int x = 0; x < width; x++) {
+                    out[x * channels + c] = (uchar)((sum * scale + (1 << 15)) >> 16);
+                    sum += in[std::min(x + radius + 1, width - 1) * channels + c]
+                         - in[std::max(x - radius, 0) * channels + c];
+                }
+            }
+        }
+    });
+}
+
+// Writes one output row from the column sums, then slides the window down
+// by one row. This is where most of the work is, so it is vectorized.
+void slideColumnSums(int* sums, const uchar* addRow, const uchar* subRow,
+                     uchar* out, int count, int scale) {
+    int i = 0;
+#if CV_SIMD128
+    const cv::v_int32x4 vScale = cv::v_setall_s32(scale);
+    const cv::v_int32x4 vHalf = cv::v_setall_s32(1 << 15);
+    for (; i <= count - 8; i += 8) {
+        cv::v_int32x4 s0 = cv::v_load(sums + i);
+        cv::v_int32x4 s1 = cv::v_load(sums + i + 4);
+
+        cv::v_int32x4 o0 = cv::v_shr<16>(cv::v_add(cv::v_mul(s0, vScale), vHalf));
+        cv::v_int32x4 o1 = cv::v_shr<16>(cv::v_add(cv::v_mul(s1, vScale), vHalf));
+        cv::v_pack_u_store(out + i, cv::v_pack(o0, o1));
+
+        cv::v_uint32x4 a0, a1, b0, b1;
+        cv::v_expand(cv::v_load_expand(addRow + i), a0, a1);
+        cv::v_expand(cv::v_load_expand(subRow + i), b0, b1);
+        s0 = cv::v_add(s0, cv::v_sub(cv::v_reinterpret_as_s32(a0), cv::v_reinterpret_as_s32(b0)));
+        s1 = cv::v_add(s1, cv::v_sub(cv::v_reinterpret_as_s32(a1), cv::v_reinterpret_as_s32(b1)));
+        cv::v_store(sums + i, s0);
+        cv::v_store(sums + i + 4, s1);
+    }
+#endif
+    for (; i < count; i++) {
+        out[i] = (uchar)((sums[i] * scale + (1 << 15)) >> 16);
+        sums[i] += addRow[i] - subRow[i];
+    }
+}
+
+// Vertical running sum, processed in strips of columns so each task keeps
+// its sums in cache
+void boxBlurColumns(const cv::Mat& src, cv::Mat& dst, int radius) {
+    const int rows = src.rows;
+    const int rowElements = src.cols * src.channels();
+    const int scale = windowScale(radius);
+    const int strips = (rowElements + kColumnStrip - 1) / kColumnStrip;
+
+    cv::parallel_for_(cv::Range(0, strips), [&](const cv::Range& range) {
+        std::vector<int> sums(kColumnStrip);
+        for (int strip = range.start; strip < range.end; strip++) {
+            const int begin = strip * kColumnStrip;
+            const int count = std::min(kColumnStrip, rowElements - begin);
+
+            const uchar* first = src.ptr<uchar>(0) + begin;
+            for (int i = 0; i < count; i++) sums[i] = (radius + 1) * first[i];
+            for (int k = 1; k <= radius; k++) {
+                const uchar* row = src.ptr<uchar>(std::min(k, rows - 1)) + begin;
+                for (int i = 0; i < count; i++) sums[i] += row[i];
+            }
+
+            for (int y = 0; y < rows; y++) {
+                const uchar* addRow = src.ptr<uchar>(std::min(y + radius + 1, rows - 1)) + begin;
+                const uchar* subRow = src.ptr<uchar>(std::max(y - radius, 0)) + begin;
+                slideColumnSums(sums.data(), addRow, subRow, dst.ptr<uchar>(y) + begin, count, scale);
+            }
+        }
+    });
+}
+
+void boxBlurPass(cv::Mat& frame, cv::Mat& scratch, int radius) {
+    if (radius <= 0) return;
+    scratch.create(frame.size(), frame.type());
+    boxBlurRows(frame, scratch, radius);
+    boxBlurColumns(scratch, frame, radius);
+}
+
+} // namespace
+
+void applyBoxBlurCPU(cv::Mat& frame, int radius, cv::Mat& scratch) {
+    CV_Assert(frame.depth() == CV_8U && frame.channels() <= 4);
+    boxBlurPass(frame, scratch, std::min(radius, kMaxBlurRadiusCPU));
+}
+
+void applyGaussianBlurCPU(cv::Mat& frame, int radius, cv::Mat& scratch) {
+    CV_Assert(frame.depth() == CV_8U && frame.channels() <= 4);
+    int radii[3];
+    gaussianBoxRadii(std::min(radius, kMaxBlurRadiusCPU) / 3.0f, radii);
+
+    for (int pass = 0; pass < 3; pass++) {
+        boxBlurPass(frame, scratch, radii[pass]);
+    }
+}
+
+// Box widths from "Fast Almost-Gaussian Filtering" (Kovesi): n passes of
+// widths wl or wl + 2 chosen so the summed variance matches sigma^2
+void gaussianBoxRadii(float sigma, int radii[3]) {
+    const int passes = 3;
+    float variance = sigma * sigma;
+
+    int lower = (int)std::floor(std::sqrt(12.0f * variance / passes + 1.0f));
+    if (lower % 2 == 0) lower--;
+    int upper = lower + 2;
+
+    float idealLower = (12.0f * variance - passes * lower * lower - 4.0f * passes * lower - 3.0f * passes)
+                     / (-4.0f * lower - 4.0f);
+    int lowerCount = (int)std::round(idealLower);
+
+    for (int i = 0; i < passes; i++) {
+        int width = i < lowerCount ? lower : upper;
+        radii[i] = (width - 1) / 2;
+    }
+}
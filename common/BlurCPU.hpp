@@ -0,0 +1,26 @@
+﻿#ifndef BLURCPU_HPP
+#define BLURCPU_HPP
+
+#include <opencv2/core.hpp>
+
+// Radius-independent CPU blurs for 8-bit images (1-4 channels).
+// Both use running-sum box passes, so the cost per pixel stays constant
+// for any radius; edges are clamped. 'scratch' is an intermediate buffer of
+// the frame's size and type; pass the same Mat every frame to avoid
+// reallocating it. Radii are clamped to kMaxBlurRadiusCPU.
+
+// Largest radius whose window (255 samples) keeps the 16.16 fixed-point
+// average within 8 bits
+const int kMaxBlurRadiusCPU = 127;
+
+// Box blur over a (2*radius+1)^2 window
+void applyBoxBlurCPU(cv::Mat& frame, int radius, cv::Mat& scratch);
+
+// Gaussian blur with support +/-radius (sigma = radius / 3), approximated
+// by three successive box blurs
+void applyGaussianBlurCPU(cv::Mat& frame, int radius, cv::Mat& scratch);
+
+// Box radii whose three passes approximate a Gaussian of the given sigma
+void gaussianBoxRadii(float sigma, int radii[3]);
+
+#endif
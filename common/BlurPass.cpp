@@ -0,0 +1,45 @@
+﻿#include "BlurPass.hpp"
+
+BlurPass::BlurPass(const char* vertex_path, const char* fragment_path, ResourcePool* pool)
+    : pool(pool), horizontalTarget(nullptr), verticalTarget(nullptr) {
+    shader = new Shader(vertex_path, fragment_path);
+    quad = new FullscreenQuad();
+}
+
+BlurPass::~BlurPass() {
+    delete shader;
+    delete quad;
+    delete horizontalTarget;
+    delete verticalTarget;
+}
+
+Texture* BlurPass::apply(Texture* source, int width, int height, int radius, bool gaussian) {
+    if (!horizontalTarget) {
+        horizontalTarget = new FrameBuffer(width, height, pool);
+        verticalTarget = new FrameBuffer(width, height, pool);
+    }
+    horizontalTarget->resize(width, height);
+    verticalTarget->resize(width, height);
+
+    FrameBufferScope scope;
+    runPass(source, horizontalTarget, 1.0f / width, 0.0f, radius, gaussian);
+    runPass(horizontalTarget->getTexture(), verticalTarget, 0.0f, 1.0f / height, radius, gaussian);
+
+    return verticalTarget->getTexture();
+}
+
+void BlurPass::runPass(Texture* input, FrameBuffer* target, float stepX, float stepY,
+                       int radius, bool gaussian) {
+    target->bind();
+
+    shader->use();
+    glActiveTexture(GL_TEXTURE0);
+    input->bind();
+    shader->setInt("textureSampler", 0);
+    shader->setVec2("uDirection", glm::vec2(stepX, stepY));
+    shader->setInt("uRadius", radius);
+    shader->setInt("uGaussian", gaussian ? 1 : 0);
+    shader->setFloat("uSigma", radius / 3.0f);
+
+    quad->draw();
+}
@@ -0,0 +1,33 @@
+﻿#ifndef BLURPASS_HPP
+#define BLURPASS_HPP
+
+#include "Shader.hpp"
+#include "Texture.hpp"
+#include "FrameBuffer.hpp"
+#include "FullscreenQuad.hpp"
+
+// Separable GPU blur: a horizontal and a vertical pass, each rendered into
+// its own framebuffer. The fragment shader pairs neighbouring taps into one
+// bilinear fetch, so a radius-r pass takes about r/2 + 1 samples per side.
+class BlurPass {
+public:
+    BlurPass(const char* vertex_path, const char* fragment_path, ResourcePool* pool = nullptr);
+    ~BlurPass();
+
+    // Blurs source (width x height) and returns the result texture, which is
+    // owned by the pass (or its pool) and valid until the next call. Box blur
+    // averages a (2*radius+1)^2 window; Gaussian uses sigma = radius / 3.
+    Texture* apply(Texture* source, int width, int height, int radius, bool gaussian);
+
+private:
+    void runPass(Texture* input, FrameBuffer* target, float stepX, float stepY,
+                 int radius, bool gaussian);
+
+    ResourcePool* pool;
+    Shader* shader;
+    FullscreenQuad* quad;
+    FrameBuffer* horizontalTarget;
+    FrameBuffer* verticalTarget;
+};
+
+#endif
@@ -0,0 +1,60 @@
+﻿#include "FrameBuffer.hpp"
+#include "ResourcePool.hpp"
+#include <iostream>
+
+FrameBuffer::FrameBuffer(int width, int height, ResourcePool* pool, GLint internalFormat)
+    : pool(pool), internalFormat(internalFormat), colorTexture(nullptr), width(width), height(height) {
+    glGenFramebuffers(1, &framebufferID);
+    attachTexture();
+}
+
+FrameBuffer::~FrameBuffer() {
+    glDeleteFramebuffers(1, &framebufferID);
+    if (!pool) delete colorTexture;
+}
+
+void FrameBuffer::resize(int newWidth, int newHeight) {
+    if (newWidth == width && newHeight == height) return;
+    width = newWidth;
+    height = newHeight;
+    attachTexture();
+}
+
+void FrameBuffer::bind() {
+    glBindFramebuffer(GL_FRAMEBUFFER, framebufferID);
+    glViewport(0, 0, width, height);
+}
+
+void FrameBuffer::attachTexture() {
+    FrameBufferScope scope;
+
+    if (pool) {
+        colorTexture = pool->getTexture(width, height, false, this, 0, internalFormat);
+    } else {
+        delete colorTexture;
+        colorTexture = new Texture(nullptr, width, height, false, internalFormat);
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, framebufferID);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D,
+                           colorTexture->textureID, 0);
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        std::cerr << "Framebuffer " << width << "x" << height << " is incomplete" << std::endl;
+    }
+}
+
+// --- FrameBufferScope ---
+
+FrameBufferScope::FrameBufferScope() : previousFramebuffer(0) {
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFramebuffer);
+    glGetIntegerv(GL_VIEWPORT, previousViewport);
+}
+
+FrameBufferScope::FrameBufferScope(FrameBuffer* target) : FrameBufferScope() {
+    target->bind();
+}
+
+FrameBufferScope::~FrameBufferScope() {
+    glBindFramebuffer(GL_FRAMEBUFFER, previousFramebuffer);
+    glViewport(previousViewport[0], previousViewport[1], previousViewport[2], previousViewport[3]);
+}
@@ -0,0 +1,56 @@
+﻿#ifndef FRAMEBUFFER_HPP
+#define FRAMEBUFFER_HPP
+
+#include "Texture.hpp"
+#include <glad/glad.h>
+
+class ResourcePool;
+
+// Offscreen render target with a single RGBA color texture (8-bit unless
+// another internal format is requested). With a pool the
+// color texture of every size is taken from (and left in) the pool, so
+// switching back to a size only re-attaches the existing texture.
+class FrameBuffer {
+public:
+    GLuint framebufferID;
+
+    FrameBuffer(int width, int height, ResourcePool* pool = nullptr, GLint internalFormat = GL_RGBA8);
+    ~FrameBuffer();
+
+    // Attaches a color texture of the new size if the size changed
+    void resize(int width, int height);
+    // Binds for drawing and sets the viewport to the target size
+    void bind();
+
+    Texture* getTexture() { return colorTexture; }
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+
+private:
+    void attachTexture();
+
+    ResourcePool* pool;
+    GLint internalFormat;
+    Texture* colorTexture;
+    int width;
+    int height;
+};
+
+// Saves the current framebuffer binding and viewport and restores them when
+// the scope ends, so passes can render offscreen without disturbing the
+// caller's render target. The second form also binds the given target.
+class FrameBufferScope {
+public:
+    FrameBufferScope();
+    explicit FrameBufferScope(FrameBuffer* target);
+    ~FrameBufferScope();
+
+    FrameBufferScope(const FrameBufferScope&) = delete;
+    FrameBufferScope& operator=(const FrameBufferScope&) = delete;
+
+private:
+    GLint previousFramebuffer;
+    GLint previousViewport[4];
+};
+
+#endif
@@ -0,0 +1,57 @@
+﻿#include "FrameHistory.hpp"
+#include "ResourcePool.hpp"
+
+FrameHistory::FrameHistory(int layers, ResourcePool* pool)
+    : textureID(0), pool(pool), layers(layers), newest(-1), count(0), width(0), height(0), rgb(true) {
+    if (pool) return;
+    glGenTextures(1, &textureID);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, textureID);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+}
+
+FrameHistory::~FrameHistory() {
+    if (!pool) glDeleteTextures(1, &textureID);
+}
+
+void FrameHistory::allocate(int newWidth, int newHeight, bool newRgb) {
+    width = newWidth;
+    height = newHeight;
+    rgb = newRgb;
+    reset();
+
+    if (pool) {
+        textureID = pool->getTextureArray(width, height, layers, rgb, this);
+        return;
+    }
+    GLenum format = rgb ? GL_RGB : GL_RGBA;
+    GLint internalFormat = rgb ? GL_RGB8 : GL_RGBA8;
+    glBindTexture(GL_TEXTURE_2D_ARRAY, textureID);
+    glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, internalFormat, width, height, layers, 0,
+                 format, GL_UNSIGNED_BYTE, nullptr);
+}
+
+void FrameHistory::push(unsigned char* data, int frameWidth, int frameHeight, bool frameRgb) {
+    if (frameWidth != width || frameHeight != height || frameRgb != rgb) {
+        allocate(frameWidth, frameHeight, frameRgb);
+    }
+
+    newest = (newest + 1) % layers;
+    if (count < layers) count++;
+
+    glBindTexture(GL_TEXTURE_2D_ARRAY, textureID);
+    GLenum format = rgb ? GL_RGB : GL_RGBA;
+    glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, newest, width, height, 1,
+                    format, GL_UNSIGNED_BYTE, data);
+}
+
+void FrameHistory::reset() {
+    newest = -1;
+    count = 0;
+}
+
+void FrameHistory::bind() {
+    glBindTexture(GL_TEXTURE_2D_ARRAY, textureID);
+}
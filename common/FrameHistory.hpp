@@ -0,0 +1,45 @@
+﻿#ifndef FRAMEHISTORY_HPP
+#define FRAMEHISTORY_HPP
+
+#include <glad/glad.h>
+
+class ResourcePool;
+
+// Ring of the last N frames kept on the GPU in one GL_TEXTURE_2D_ARRAY.
+// Each frame is uploaded once, straight into the next layer; temporal
+// shaders then read any past frame without re-uploading it. With a pool,
+// the array for each frame size comes from the pool and is kept there.
+class FrameHistory {
+public:
+    GLuint textureID;
+
+    explicit FrameHistory(int layers, ResourcePool* pool = nullptr);
+    ~FrameHistory();
+
+    // Uploads a frame into the next layer. The history is cleared and a
+    // different array is used (or this one reallocated) if the frame size or
+    // format changes.
+    void push(unsigned char* data, int width, int height, bool rgb);
+    // Forgets all stored frames without freeing the array
+    void reset();
+    void bind();
+
+    int getLayerCount() const { return layers; }
+    int getFrameCount() const { return count; }   // valid layers, <= layer count
+    int getNewestLayer() const { return newest; }
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+
+private:
+    void allocate(int width, int height, bool rgb);
+
+    ResourcePool* pool;
+    int layers;
+    int newest;
+    int count;
+    int width;
+    int height;
+    bool rgb;
+};
+
+#endif
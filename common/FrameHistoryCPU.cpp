@@ -0,0 +1,93 @@
+﻿#include "FrameHistoryCPU.hpp"
+#include "ResourcePool.hpp"
+#include <opencv2/imgproc.hpp>
+#include <algorithm>
+
+FrameHistoryCPU::FrameHistoryCPU(int layers, ResourcePool* pool)
+    : pool(pool), slots(layers), newest(-1), count(0), emaValid(false), emaPending(0) {}
+
+void FrameHistoryCPU::allocate(const cv::Mat& frame) {
+    int sumType = CV_MAKETYPE(CV_32S, frame.channels());
+    if (pool) {
+        // Slots, sum and scratch buffers all come from the pool; the OpenCV
+        // calls in the filters then write into them in place
+        int width = frame.cols;
+        int height = frame.rows;
+        int index = 0;
+        for (cv::Mat& slot : slots) slot = pool->getCpuBuffer(width, height, frame.type(), this, index++);
+        runningSum = pool->getCpuBuffer(width, height, sumType, this, index++);
+        accumulator = pool->getCpuBuffer(width, height, CV_MAKETYPE(CV_32F, frame.channels()), this, index++);
+        difference = pool->getCpuBuffer(width, height, frame.type(), this, index++);
+        luma = pool->getCpuBuffer(width, height, CV_8UC1, this, index++);
+    } else {
+        for (cv::Mat& slot : slots) slot.create(frame.size(), frame.type());
+        runningSum.create(frame.size(), sumType);
+    }
+    reset();
+}
+
+void FrameHistoryCPU::push(const cv::Mat& frame) {
+    if (slots[0].size() != frame.size() || slots[0].type() != frame.type()) {
+        allocate(frame);
+    }
+
+    int next = (newest + 1) % (int)slots.size();
+    // Keep the running sum of the ring current: drop the frame being overwritten
+    if (count == (int)slots.size()) {
+        cv::subtract(runningSum, slots[next], runningSum, cv::noArray(), CV_32S);
+    }
+    frame.copyTo(slots[next]);
+    cv::add(runningSum, slots[next], runningSum, cv::noArray(), CV_32S);
+
+    newest = next;
+    if (count < (int)slots.size()) count++;
+    emaPending++;
+}
+
+void FrameHistoryCPU::reset() {
+    newest = -1;
+    count = 0;
+    emaValid = false;
+    emaPending = 0;
+    runningSum.setTo(cv::Scalar::all(0));
+}
+
+const cv::Mat& FrameHistoryCPU::getFrame(int age) const {
+    int size = (int)slots.size();
+    return slots[(newest - age + size) % size];
+}
+
+// Mean of the stored frames from the running sum: O(1) per pixel in N
+void FrameHistoryCPU::applyDenoise(cv::Mat& out) {
+    if (count == 0) return;
+    runningSum.convertTo(out, slots[0].type(), 1.0 / count);
+}
+
+void FrameHistoryCPU::applyMotionMask(cv::Mat& out, float threshold) {
+    if (count < 2) {
+        out.create(slots[0].size(), slots[0].type());
+        out.setTo(cv::Scalar::all(0));
+        return;
+    }
+    cv::absdiff(getFrame(0), getFrame(1), difference);
+    cv::cvtColor(difference, luma, cv::COLOR_BGR2GRAY);
+    cv::threshold(luma, luma, threshold * 255.0f, 255, cv::THRESH_BINARY);
+    cv::cvtColor(luma, out, cv::COLOR_GRAY2BGR);
+}
+
+// Same recurrence as the GPU shader. Normally one frame is pending, so this
+// is a single blend per pixel; frames the ring has already dropped are lost.
+void FrameHistoryCPU::applyEMA(cv::Mat& out, float alpha) {
+    if (count == 0) return;
+    int pending = std::min(emaPending, count);
+    if (!emaValid) {
+        getFrame(pending - 1).convertTo(accumulator, CV_32F);
+        pending--;
+        emaValid = true;
+    }
+    for (int age = pending - 1; age >= 0; age--) {
+        cv::accumulateWeighted(getFrame(age), accumulator, alpha);
+    }
+    emaPending = 0;
+    accumulator.convertTo(out, slots[0].type());
+}
@@ -0,0 +1,48 @@
+﻿#ifndef FRAMEHISTORYCPU_HPP
+#define FRAMEHISTORYCPU_HPP
+
+#include <opencv2/core.hpp>
+#include <vector>
+
+class ResourcePool;
+
+// CPU counterpart of FrameHistory: a preallocated ring of the last N frames
+// plus the temporal operations of TemporalPass, so both paths can be
+// compared. Slots and scratch buffers are only reallocated when the frame
+// size or type changes; with a pool they are taken from it per size instead.
+class FrameHistoryCPU {
+public:
+    explicit FrameHistoryCPU(int layers, ResourcePool* pool = nullptr);
+
+    // Copies the frame into the next slot
+    void push(const cv::Mat& frame);
+    void reset();
+
+    // Frame from 'age' frames ago (0 = newest)
+    const cv::Mat& getFrame(int age) const;
+    int getFrameCount() const { return count; }
+
+    void applyDenoise(cv::Mat& out);
+    void applyMotionMask(cv::Mat& out, float threshold);
+    // Blends the frames pushed since the last call into a running
+    // accumulator (acc = alpha * frame + (1 - alpha) * acc); restarts from
+    // the newest frame after a reset
+    void applyEMA(cv::Mat& out, float alpha);
+
+private:
+    void allocate(const cv::Mat& frame);
+
+    ResourcePool* pool;
+    std::vector<cv::Mat> slots;
+    int newest;
+    int count;
+    bool emaValid;      // accumulator holds the EMA up to emaPending frames ago
+    int emaPending;     // frames pushed since the last applyEMA
+
+    cv::Mat runningSum;     // CV_32S sum of the stored frames, updated per push
+    cv::Mat accumulator;    // CV_32F running EMA, kept across frames
+    cv::Mat difference;
+    cv::Mat luma;
+};
+
+#endif
@@ -0,0 +1,30 @@
+﻿#include "FullscreenQuad.hpp"
+
+FullscreenQuad::FullscreenQuad() {
+    GLfloat vertices[] = {
+        -1.0f, -1.0f,
+         1.0f, -1.0f,
+         1.0f,  1.0f,
+         1.0f,  1.0f,
+        -1.0f,  1.0f,
+        -1.0f, -1.0f
+    };
+
+    glGenBuffers(1, &vertexBuffer);
+    glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+}
+
+FullscreenQuad::~FullscreenQuad() {
+    glDeleteBuffers(1, &vertexBuffer);
+}
+
+void FullscreenQuad::draw() {
+    glEnableVertexAttribArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 0, (void*)0);
+
+    glDrawArrays(GL_TRIANGLES, 0, 6);
+
+    glDisableVertexAttribArray(0);
+}
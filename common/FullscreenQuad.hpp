@@ -0,0 +1,19 @@
+﻿#ifndef FULLSCREENQUAD_HPP
+#define FULLSCREENQUAD_HPP
+
+#include <glad/glad.h>
+
+// Clip-space quad covering the whole viewport, for image-processing passes.
+// Positions are fed to attribute 0 as vec2 in [-1, 1].
+class FullscreenQuad {
+public:
+    FullscreenQuad();
+    ~FullscreenQuad();
+
+    void draw();
+
+private:
+    GLuint vertexBuffer;
+};
+
+#endif
@@ -0,0 +1,34 @@
+﻿#include "GpuTimer.hpp"
+
+GpuTimer::GpuTimer() : issued(0), collected(0) {
+    glGenQueries(kQueries, queries);
+}
+
+GpuTimer::~GpuTimer() {
+    glDeleteQueries(kQueries, queries);
+}
+
+void GpuTimer::begin() {
+    // Every query still in flight: give up on the oldest instead of blocking
+    if (issued - collected == kQueries) collected++;
+    glBeginQuery(GL_TIME_ELAPSED, queries[issued % kQueries]);
+}
+
+void GpuTimer::end() {
+    glEndQuery(GL_TIME_ELAPSED);
+    issued++;
+}
+
+bool GpuTimer::nextResult(double& milliseconds, uint64_t& interval) {
+    if (collected == issued) return false;
+    GLuint query = queries[collected % kQueries];
+    GLint available = 0;
+    glGetQueryObjectiv(query, GL_QUERY_RESULT_AVAILABLE, &available);
+    if (!available) return false;
+
+    GLuint64 elapsedNs = 0;
+    glGetQueryObjectui64v(query, GL_QUERY_RESULT, &elapsedNs);
+    milliseconds = elapsedNs / 1.0e6;
+    interval = collected++;
+    return true;
+}
@@ -0,0 +1,33 @@
+﻿#ifndef GPUTIMER_HPP
+#define GPUTIMER_HPP
+
+#include <glad/glad.h>
+#include <cstdint>
+
+// GL_TIME_ELAPSED timer for work issued every frame. Intervals go through a
+// small ring of queries and results are only read once GL reports them
+// available, so timing never stalls the render loop; a slow GPU just returns
+// them a few frames late. If the ring fills up, the oldest interval is
+// dropped rather than waited for.
+class GpuTimer {
+public:
+    static const int kQueries = 4;
+
+    GpuTimer();
+    ~GpuTimer();
+
+    void begin();
+    void end();
+    // Number of intervals ended so far; the one just ended is count - 1
+    uint64_t getIntervalCount() const { return issued; }
+    // Oldest finished interval not returned before, in issue order. Returns
+    // false if none is available yet.
+    bool nextResult(double& milliseconds, uint64_t& interval);
+
+private:
+    GLuint queries[kQueries];
+    uint64_t issued;      // intervals ended
+    uint64_t collected;   // intervals read or dropped
+};
+
+#endif
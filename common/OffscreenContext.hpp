@@ -0,0 +1,33 @@
+﻿#ifndef OFFSCREENCONTEXT_HPP
+#define OFFSCREENCONTEXT_HPP
+
+#include "FrameBuffer.hpp"
+#include <EGL/egl.h>
+
+// Headless OpenGL 3.3 core context on a surfaceless EGL display (works with
+// Mesa llvmpipe on machines without a display). Rendering goes into an
+// offscreen framebuffer instead of a window; everything else uses the same
+// Shader/Texture/Quad code as the windowed path.
+class OffscreenContext {
+public:
+    OffscreenContext();
+    ~OffscreenContext();
+
+    // Creates the context, makes it current, loads GL and allocates the
+    // render target. Returns false if no suitable EGL device is available.
+    bool init(int width, int height);
+
+    // Binds the offscreen render target; call before drawing each frame
+    void bind();
+    // Waits for the frame to finish rendering (stands in for a buffer swap)
+    void present();
+
+    FrameBuffer* getFrameBuffer() { return renderTarget; }
+
+private:
+    EGLDisplay display;
+    EGLContext context;
+    FrameBuffer* renderTarget;
+};
+
+#endif
@@ -0,0 +1,35 @@
+﻿#include "OutputPass.hpp"
+
+OutputPass::OutputPass(const char* vertex_path, const char* fragment_path, ResourcePool* pool)
+    : pool(pool), target(nullptr) {
+    shader = new Shader(vertex_path, fragment_path);
+    quad = new FullscreenQuad();
+}
+
+OutputPass::~OutputPass() {
+    delete shader;
+    delete quad;
+    delete target;
+}
+
+FrameBuffer* OutputPass::apply(Texture* source, int width, int height, int filterMode, int pixelSize) {
+    if (!target) target = new FrameBuffer(width, height, pool);
+    target->resize(width, height);
+
+    FrameBufferScope scope(target);
+    shader->use();
+    glActiveTexture(GL_TEXTURE0);
+    source->bind();
+    shader->setInt("textureSampler", 0);
+    // Textures hold the frame bottom row first; flip so readback starts at the top
+    shader->setInt("uFlipY", 1);
+    shader->setInt("filterMode", filterMode);
+    shader->setInt("pixelSize", pixelSize);
+    shader->setFloat("uTranslateX", 0.0f);
+    shader->setFloat("uTranslateY", 0.0f);
+    shader->setFloat("uRotation", 0.0f);
+    shader->setFloat("uScale", 1.0f);
+    quad->draw();
+
+    return target;
+}
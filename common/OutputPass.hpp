@@ -0,0 +1,29 @@
+﻿#ifndef OUTPUTPASS_HPP
+#define OUTPUTPASS_HPP
+
+#include "Shader.hpp"
+#include "Texture.hpp"
+#include "FrameBuffer.hpp"
+#include "FullscreenQuad.hpp"
+
+// Renders the processed frame at its own resolution, top row first and
+// without the view transform, so GPU output can be read back with the same
+// geometry as the CPU path's frames. Pixelate and grayscale run here with
+// the display shader; blur and temporal results are passed through.
+class OutputPass {
+public:
+    OutputPass(const char* vertex_path, const char* fragment_path, ResourcePool* pool = nullptr);
+    ~OutputPass();
+
+    // filterMode follows the display shader (0 none, 1 pixelate, 2 grayscale).
+    // Returns the target, owned by the pass and valid until the next call.
+    FrameBuffer* apply(Texture* source, int width, int height, int filterMode, int pixelSize);
+
+private:
+    ResourcePool* pool;
+    Shader* shader;
+    FullscreenQuad* quad;
+    FrameBuffer* target;
+};
+
+#endif
@@ -0,0 +1,57 @@
+﻿#include "PixelReadback.hpp"
+
+PixelReadback::PixelReadback() : current(0), mapped(false), width(0), height(0) {
+    glGenBuffers(2, pixelBuffers);
+    pending[0] = pending[1] = false;
+}
+
+PixelReadback::~PixelReadback() {
+    release();
+    glDeleteBuffers(2, pixelBuffers);
+}
+
+void PixelReadback::allocate(int newWidth, int newHeight) {
+    width = newWidth;
+    height = newHeight;
+    for (int i = 0; i < 2; i++) {
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, pixelBuffers[i]);
+        glBufferData(GL_PIXEL_PACK_BUFFER, (GLsizeiptr)width * height * 3, nullptr, GL_STREAM_READ);
+        pending[i] = false;
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+}
+
+const unsigned char* PixelReadback::read(int newWidth, int newHeight) {
+    release();
+    if (newWidth != width || newHeight != height) allocate(newWidth, newHeight);
+
+    // Queue this frame into the current buffer
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, pixelBuffers[current]);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, width, height, GL_BGR, GL_UNSIGNED_BYTE, (void*)0);
+    pending[current] = true;
+
+    // Map the buffer queued one frame ago
+    int previous = 1 - current;
+    current = previous;
+    if (!pending[previous]) {
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        return nullptr;
+    }
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, pixelBuffers[previous]);
+    const unsigned char* pixels = (const unsigned char*)glMapBufferRange(
+        GL_PIXEL_PACK_BUFFER, 0, (GLsizeiptr)width * height * 3, GL_MAP_READ_BIT);
+    pending[previous] = false;
+    mapped = pixels != nullptr;
+    if (!mapped) glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    return pixels;
+}
+
+void PixelReadback::release() {
+    if (!mapped) return;
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, pixelBuffers[current]);
+    glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    mapped = false;
+}
@@ -0,0 +1,33 @@
+﻿#ifndef PIXELREADBACK_HPP
+#define PIXELREADBACK_HPP
+
+#include <glad/glad.h>
+
+// Asynchronous BGR readback of the bound framebuffer through two pixel
+// buffer objects. Each call queues a read of the current frame and maps the
+// buffer filled on the previous call, so the CPU never waits for the frame
+// it just submitted (one frame of latency).
+class PixelReadback {
+public:
+    PixelReadback();
+    ~PixelReadback();
+
+    // Queues a read of the (width x height) framebuffer and returns the
+    // previous frame's pixels (BGR8, tightly packed, first row = framebuffer
+    // row 0), or nullptr if none is ready yet. The pointer stays valid until
+    // release().
+    const unsigned char* read(int width, int height);
+    void release();
+
+private:
+    void allocate(int width, int height);
+
+    GLuint pixelBuffers[2];
+    int current;
+    bool pending[2];
+    bool mapped;
+    int width;
+    int height;
+};
+
+#endif
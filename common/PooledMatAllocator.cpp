@@ -0,0 +1,252 @@
+﻿#include "PooledMatAllocator.hpp"
+#include <algorithm>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#include <cstdio>
+#endif
+#ifdef __APPLE__
+#include <mach/mach.h>
+#endif
+
+namespace {
+const size_t kHugePageBytes = 2 * 1024 * 1024;
+const size_t kSmallPageBytes = 64 * 1024;
+}
+
+PooledMatAllocator& PooledMatAllocator::instance() {
+    static PooledMatAllocator* allocator = new PooledMatAllocator();
+    return *allocator;
+}
+
+size_t PooledMatAllocator::sizeClass(size_t bytes) {
+    size_t granularity = bytes >= kHugePageBytes ? kHugePageBytes : kSmallPageBytes;
+    return (bytes + granularity - 1) / granularity * granularity;
+}
+
+void* PooledMatAllocator::mapBuffer(size_t bytes) {
+#ifdef _WIN32
+    // Large pages need SeLockMemoryPrivilege; fall back to normal pages without it
+    SIZE_T largePage = GetLargePageMinimum();
+    if (largePage && bytes % largePage == 0) {
+        void* ptr = VirtualAlloc(nullptr, bytes, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES,
+                                 PAGE_READWRITE);
+        if (ptr) return ptr;
+    }
+    return VirtualAlloc(nullptr, bytes, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+#else
+    if (bytes < kHugePageBytes) {
+        void* ptr = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        return ptr == MAP_FAILED ? nullptr : ptr;
+    }
+
+    // Over-map so the buffer can start on a huge-page boundary, then trim
+    size_t mapped = bytes + kHugePageBytes;
+    void* raw = mmap(nullptr, mapped, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == MAP_FAILED) return nullptr;
+
+    uintptr_t start = (uintptr_t)raw;
+    uintptr_t aligned = (start + kHugePageBytes - 1) & ~(uintptr_t)(kHugePageBytes - 1);
+    if (aligned > start) munmap(raw, aligned - start);
+    size_t tail = (start + mapped) - (aligned + bytes);
+    if (tail) munmap((void*)(aligned + bytes), tail);
+
+#ifdef MADV_HUGEPAGE
+    madvise((void*)aligned, bytes, MADV_HUGEPAGE);
+#endif
+    return (void*)aligned;
+#endif
+}
+
+void PooledMatAllocator::unmapBuffer(void* ptr, size_t bytes) {
+#ifdef _WIN32
+    (void)bytes;
+    VirtualFree(ptr, 0, MEM_RELEASE);
+#else
+    munmap(ptr, bytes);
+#endif
+}
+
+cv::UMatData* PooledMatAllocator::allocate(int dims, const int* sizes, int type, void* data0,
+                                           size_t* step, cv::AccessFlag /*flags*/,
+                                           cv::UMatUsageFlags /*usageFlags*/) const {
+    // Same step computation as OpenCV's default allocator
+    size_t total = CV_ELEM_SIZE(type);
+    for (int i = dims - 1; i >= 0; i--) {
+        if (step) {
+            if (data0 && step[i] != CV_AUTOSTEP) {
+                CV_Assert(total <= step[i]);
+                total = step[i];
+            } else {
+                step[i] = total;
+            }
+        }
+        total *= sizes[i];
+    }
+
+    cv::UMatData* u = new cv::UMatData(this);
+    u->size = total;
+
+    if (data0) {
+        u->data = u->origdata = (uchar*)data0;
+        u->flags |= cv::UMatData::USER_ALLOCATED;
+        return u;
+    }
+
+    if (total < kMinPooledBytes) {
+        u->data = u->origdata = (uchar*)cv::fastMalloc(total);
+        std::lock_guard<std::mutex> lock(mutex);
+        stats.smallAllocations++;
+        return u;
+    }
+
+    size_t bytes = sizeClass(total);
+    void* buffer = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stats.allocations++;
+        std::vector<void*>& freeList = freeLists[bytes];
+        if (!freeList.empty()) {
+            buffer = freeList.back();
+            freeList.pop_back();
+            stats.poolHits++;
+            stats.bytesPooled -= bytes;
+            stats.bytesInUse += bytes;
+            liveBuffers[buffer] = bytes;
+        }
+    }
+
+    if (!buffer) {
+        buffer = mapBuffer(bytes);
+        if (!buffer) {
+            delete u;
+            CV_Error(cv::Error::StsNoMem, "PooledMatAllocator: failed to map frame buffer");
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        stats.bytesInUse += bytes;
+        stats.peakBytesResident = std::max(stats.peakBytesResident,
+                                           stats.bytesInUse + stats.bytesPooled);
+        liveBuffers[buffer] = bytes;
+    }
+
+    u->data = u->origdata = (uchar*)buffer;
+    return u;
+}
+
+bool PooledMatAllocator::allocate(cv::UMatData* u, cv::AccessFlag /*accessFlags*/,
+                                  cv::UMatUsageFlags /*usageFlags*/) const {
+    return u != nullptr;
+}
+
+void PooledMatAllocator::deallocate(cv::UMatData* u) const {
+    if (!u) return;
+    CV_Assert(u->urefcount == 0);
+    CV_Assert(u->refcount == 0);
+
+    if (!(u->flags & cv::UMatData::USER_ALLOCATED)) {
+        void* buffer = u->origdata;
+        size_t bytes = 0;
+        bool release = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto it = liveBuffers.find(buffer);
+            if (it == liveBuffers.end()) {
+                // Below the pooling threshold, came from fastMalloc
+                bytes = 0;
+            } else {
+                bytes = it->second;
+                liveBuffers.erase(it);
+                stats.bytesInUse -= bytes;
+
+                std::vector<void*>& freeList = freeLists[bytes];
+                if (freeList.size() < kMaxFreePerClass) {
+                    freeList.push_back(buffer);
+                    stats.bytesPooled += bytes;
+                } else {
+                    release = true;
+                }
+            }
+        }
+
+        if (bytes == 0) {
+            cv::fastFree(buffer);
+        } else if (release) {
+            unmapBuffer(buffer, bytes);
+        }
+        u->origdata = nullptr;
+    }
+    delete u;
+}
+
+PooledMatAllocator::Stats PooledMatAllocator::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
+
+void PooledMatAllocator::resetStats() {
+    std::lock_guard<std::mutex> lock(mutex);
+    stats.allocations = 0;
+    stats.poolHits = 0;
+    stats.smallAllocations = 0;
+    stats.peakBytesResident = stats.bytesInUse + stats.bytesPooled;
+}
+
+void PooledMatAllocator::trim() {
+    std::map<size_t, std::vector<void*>> released;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        released.swap(freeLists);
+        stats.bytesPooled = 0;
+    }
+    for (auto& entry : released) {
+        for (void* buffer : entry.second) unmapBuffer(buffer, entry.first);
+    }
+}
+
+ProcessMemoryInfo ProcessMemoryInfo::query() {
+    ProcessMemoryInfo info;
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        info.pageFaults = counters.PageFaultCount;
+        info.residentBytes = counters.WorkingSetSize;
+        info.peakResidentBytes = counters.PeakWorkingSetSize;
+    }
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+        info.pageFaults = (uint64_t)usage.ru_minflt + (uint64_t)usage.ru_majflt;
+#ifdef __APPLE__
+        info.peakResidentBytes = (size_t)usage.ru_maxrss;
+#else
+        info.peakResidentBytes = (size_t)usage.ru_maxrss * 1024;
+#endif
+    }
+#ifdef __APPLE__
+    mach_task_basic_info_data_t task;
+    mach_msg_type_number_t taskCount = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, (task_info_t)&task, &taskCount) == KERN_SUCCESS) {
+        info.residentBytes = (size_t)task.resident_size;
+    }
+#else
+    // Second field of statm is the resident page count
+    FILE* statm = fopen("/proc/self/statm", "r");
+    if (statm) {
+        unsigned long long totalPages = 0, residentPages = 0;
+        if (fscanf(statm, "%llu %llu", &totalPages, &residentPages) == 2) {
+            info.residentBytes = (size_t)residentPages * (size_t)sysconf(_SC_PAGESIZE);
+        }
+        fclose(statm);
+    }
+#endif
+#endif
+    return info;
+}
@@ -0,0 +1,70 @@
+﻿#ifndef POOLEDMATALLOCATOR_HPP
+#define POOLEDMATALLOCATOR_HPP
+
+#include <opencv2/core.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <vector>
+
+// cv::MatAllocator that recycles frame-sized buffers instead of returning them
+// to the OS. Buffers are grouped into size classes (2 MiB granularity above
+// 2 MiB, huge-page backed where the OS allows it) so that the temporaries
+// OpenCV creates every frame (clone, cvtColor, warpAffine, flip) are served
+// from memory that is already mapped and faulted in.
+class PooledMatAllocator : public cv::MatAllocator {
+public:
+    struct Stats {
+        uint64_t allocations = 0;   // pooled-size requests since resetStats()
+        uint64_t poolHits = 0;      // requests served from a free list
+        uint64_t smallAllocations = 0; // below the pooling threshold (fastMalloc)
+        size_t bytesInUse = 0;
+        size_t bytesPooled = 0;     // free buffers held for reuse
+        size_t peakBytesResident = 0;
+
+        double hitRate() const { return allocations ? (double)poolHits / allocations : 0.0; }
+    };
+
+    // Process-wide instance; intentionally never destroyed, since Mats that
+    // outlive main() may still hand their buffers back to it
+    static PooledMatAllocator& instance();
+
+    cv::UMatData* allocate(int dims, const int* sizes, int type, void* data,
+                           size_t* step, cv::AccessFlag flags,
+                           cv::UMatUsageFlags usageFlags) const override;
+    bool allocate(cv::UMatData* data, cv::AccessFlag accessFlags,
+                  cv::UMatUsageFlags usageFlags) const override;
+    void deallocate(cv::UMatData* data) const override;
+
+    Stats getStats() const;
+    void resetStats();
+    // Returns every pooled (free) buffer to the OS
+    void trim();
+
+private:
+    PooledMatAllocator() = default;
+
+    static size_t sizeClass(size_t bytes);
+    static void* mapBuffer(size_t bytes);
+    static void unmapBuffer(void* ptr, size_t bytes);
+
+    static const size_t kMinPooledBytes = 256 * 1024;
+    static const size_t kMaxFreePerClass = 8;
+
+    mutable std::mutex mutex;
+    mutable std::map<size_t, std::vector<void*>> freeLists;
+    mutable std::map<void*, size_t> liveBuffers;   // pooled pointer -> size class
+    mutable Stats stats;
+};
+
+// Process-level memory counters, used to show the effect of the pool
+struct ProcessMemoryInfo {
+    uint64_t pageFaults = 0;      // minor + major faults since process start
+    size_t residentBytes = 0;     // current resident set / working set
+    size_t peakResidentBytes = 0; // lifetime high-water mark, never decreases
+
+    static ProcessMemoryInfo query();
+};
+
+#endif
@@ -2,9 +2,30 @@
 #include "TextureShader.hpp"
 #include <glm/gtc/matrix_transform.hpp>
 
-Quad::Quad(float aspectRatio) {
+Quad::Quad(float aspectRatio) : aspectRatio(0.0f) {
     vertexCount = 6;
     
+    glGenBuffers(1, &vertexBuffer);
+    setAspectRatio(aspectRatio);
+    
+    GLfloat uvs[] = {
+        0.0f, 0.0f,
+        1.0f, 0.0f,
+        1.0f, 1.0f,
+        1.0f, 1.0f,
+        0.0f, 1.0f,
+        0.0f, 0.0f
+    };
+    
+    glGenBuffers(1, &uvBuffer);
+    glBindBuffer(GL_ARRAY_BUFFER, uvBuffer);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(uvs), uvs, GL_STATIC_DRAW);
+}
+
+void Quad::setAspectRatio(float newAspectRatio) {
+    if (newAspectRatio == aspectRatio) return;
+    aspectRatio = newAspectRatio;
+    
     float width = aspectRatio;
     float height = 1.0f;
     
@@ -17,22 +38,8 @@ Quad::Quad(float aspectRatio) {
         -width, -height, 0.0f
     };
     
-    GLfloat uvs[] = {
-        0.0f, 0.0f,
-        1.0f, 0.0f,
-        1.0f, 1.0f,
-        1.0f, 1.0f,
-        0.0f, 1.0f,
-        0.0f, 0.0f
-    };
-    
-    glGenBuffers(1, &vertexBuffer);
     glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
     glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
-    
-    glGenBuffers(1, &uvBuffer);
-    glBindBuffer(GL_ARRAY_BUFFER, uvBuffer);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(uvs), uvs, GL_STATIC_DRAW);
 }
 
 Quad::~Quad() {
@@ -10,11 +10,14 @@ public:
     ~Quad();
     
     void render(const glm::mat4& view, const glm::mat4& projection) override;
+    // Rebuilds the vertex positions if the aspect ratio changed
+    void setAspectRatio(float aspectRatio);
     
 private:
     GLuint vertexBuffer;
     GLuint uvBuffer;
     int vertexCount;
+    float aspectRatio;
 };
 
 #endif
@@ -0,0 +1,107 @@
+﻿#include "ResourcePool.hpp"
+#include <cstring>
+#include <iostream>
+
+ResourcePool::ResourcePool() {}
+
+ResourcePool::~ResourcePool() {
+    for (auto& entry : textures) delete entry.second;
+    for (auto& entry : textureArrays) glDeleteTextures(1, &entry.second);
+    for (auto& entry : pixelBuffers) glDeleteBuffers(1, &entry.second);
+}
+
+void ResourcePool::recordMiss(const char* kind, int width, int height, uint64_t bytes) {
+    stats.misses++;
+    stats.bytesAllocated += bytes;
+    std::cout << "Resource pool: allocated " << kind << " " << width << "x" << height
+              << " (" << bytes / (1024.0 * 1024.0) << " MiB)" << std::endl;
+}
+
+Texture* ResourcePool::getTexture(int width, int height, bool rgb, const void* owner, int index,
+                                  GLint internalFormat) {
+    Key key(owner, index, width, height, internalFormat ? internalFormat : (rgb ? GL_RGB : GL_RGBA));
+    auto found = textures.find(key);
+    if (found != textures.end()) {
+        stats.hits++;
+        return found->second;
+    }
+
+    Texture* texture = new Texture(nullptr, width, height, rgb, internalFormat);
+    textures[key] = texture;
+    int bytesPerPixel = internalFormat == GL_RGBA16F ? 8 : (rgb ? 3 : 4);
+    recordMiss("texture", width, height, (uint64_t)width * height * bytesPerPixel);
+    return texture;
+}
+
+GLuint ResourcePool::getTextureArray(int width, int height, int layers, bool rgb, const void* owner) {
+    Key key(owner, layers, width, height, rgb ? GL_RGB : GL_RGBA);
+    auto found = textureArrays.find(key);
+    if (found != textureArrays.end()) {
+        stats.hits++;
+        return found->second;
+    }
+
+    GLuint texture;
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, texture);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, rgb ? GL_RGB8 : GL_RGBA8, width, height, layers, 0,
+                 rgb ? GL_RGB : GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    textureArrays[key] = texture;
+    recordMiss("texture array", width, height, (uint64_t)width * height * layers * (rgb ? 3 : 4));
+    return texture;
+}
+
+GLuint ResourcePool::getPixelBuffer(int width, int height, bool rgb) {
+    Key key(nullptr, 0, width, height, rgb ? GL_RGB : GL_RGBA);
+    auto found = pixelBuffers.find(key);
+    if (found != pixelBuffers.end()) {
+        stats.hits++;
+        return found->second;
+    }
+
+    GLsizeiptr bytes = (GLsizeiptr)width * height * (rgb ? 3 : 4);
+    GLuint buffer;
+    glGenBuffers(1, &buffer);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer);
+    glBufferData(GL_PIXEL_UNPACK_BUFFER, bytes, nullptr, GL_STREAM_DRAW);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    pixelBuffers[key] = buffer;
+    recordMiss("pixel buffer", width, height, (uint64_t)bytes);
+    return buffer;
+}
+
+cv::Mat ResourcePool::getCpuBuffer(int width, int height, int type, const void* owner, int index) {
+    Key key(owner, index, width, height, type);
+    auto found = cpuBuffers.find(key);
+    if (found != cpuBuffers.end()) {
+        stats.hits++;
+        return found->second;
+    }
+
+    cv::Mat buffer(height, width, type);
+    cpuBuffers[key] = buffer;
+    recordMiss("CPU buffer", width, height, (uint64_t)buffer.total() * buffer.elemSize());
+    return buffer;
+}
+
+void ResourcePool::upload(Texture* texture, const unsigned char* data, int width, int height, bool rgb) {
+    GLsizeiptr bytes = (GLsizeiptr)width * height * (rgb ? 3 : 4);
+    GLuint buffer = getPixelBuffer(width, height, rgb);
+
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer);
+    // Invalidating lets the driver hand out fresh storage instead of waiting
+    // for last frame's transfer out of this buffer to finish
+    void* mapped = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, bytes,
+                                    GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+    if (mapped) {
+        memcpy(mapped, data, (size_t)bytes);
+        glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+        texture->update(nullptr, width, height, rgb);   // offset 0 in the bound buffer
+    }
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    if (!mapped) texture->update((unsigned char*)data, width, height, rgb);
+}
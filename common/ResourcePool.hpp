@@ -0,0 +1,60 @@
+﻿#ifndef RESOURCEPOOL_HPP
+#define RESOURCEPOOL_HPP
+
+#include <glad/glad.h>
+#include <opencv2/core.hpp>
+#include <cstdint>
+#include <map>
+#include <tuple>
+
+#include "Texture.hpp"
+
+// Textures, texture arrays, upload pixel buffers and CPU frame buffers kept
+// per (width, height, format). Switching resolution back and forth reuses
+// what was allocated the first time; memory is only allocated on a miss.
+// Everything is owned by the pool and freed with it, so the pool has to
+// outlive the objects that use its resources.
+//
+// Resources with the same size and format but different contents (the two
+// blur targets, the slots of a history ring) are told apart by the owner
+// pointer and index; shared resources such as the video texture use none.
+class ResourcePool {
+public:
+    struct Stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t bytesAllocated = 0;   // texture + pixel buffer + CPU bytes
+    };
+
+    ResourcePool();
+    ~ResourcePool();
+
+    Texture* getTexture(int width, int height, bool rgb, const void* owner = nullptr, int index = 0,
+                        GLint internalFormat = 0);
+    // GL_TEXTURE_2D_ARRAY with 'layers' layers, nearest filtering
+    GLuint getTextureArray(int width, int height, int layers, bool rgb, const void* owner = nullptr);
+    // GL_PIXEL_UNPACK_BUFFER sized for one (width x height) frame
+    GLuint getPixelBuffer(int width, int height, bool rgb);
+    // Returned headers share the pooled data; the caller may write into it
+    // until the next frame
+    cv::Mat getCpuBuffer(int width, int height, int type, const void* owner = nullptr, int index = 0);
+
+    // Copies the tightly packed frame into a pooled pixel buffer and updates
+    // the texture from it, so the driver can schedule the transfer itself
+    void upload(Texture* texture, const unsigned char* data, int width, int height, bool rgb);
+
+    Stats getStats() const { return stats; }
+
+private:
+    typedef std::tuple<const void*, int, int, int, int> Key;   // owner, index, width, height, format
+
+    void recordMiss(const char* kind, int width, int height, uint64_t bytes);
+
+    std::map<Key, Texture*> textures;
+    std::map<Key, GLuint> textureArrays;
+    std::map<Key, GLuint> pixelBuffers;
+    std::map<Key, cv::Mat> cpuBuffers;
+    Stats stats;
+};
+
+#endif
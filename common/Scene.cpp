@@ -1,4 +1,5 @@
 ﻿#include "Scene.hpp"
+#include "Trace.hpp"
 
 Scene::Scene() {}
 
@@ -13,6 +14,7 @@ void Scene::addObject(Object* obj) {
 }
 
 void Scene::render(Camera* camera) {
+    TRACE_SCOPE("Scene::render");
     glm::mat4 view = camera->getViewMatrix();
     glm::mat4 projection = camera->getProjectionMatrix();
     
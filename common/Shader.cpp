@@ -23,6 +23,10 @@ void Shader::setFloat(const std::string &name, float value) {
     glUniform1f(glGetUniformLocation(programID, name.c_str()), value);
 }
 
+void Shader::setVec2(const std::string &name, const glm::vec2 &value) {
+    glUniform2f(glGetUniformLocation(programID, name.c_str()), value.x, value.y);
+}
+
 GLuint Shader::loadShaders(const char* vertex_path, const char* fragment_path) {
     // Read vertex shader
     std::string vertexCode;
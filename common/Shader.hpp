@@ -3,6 +3,7 @@
 
 #include <string>
 #include <glad/glad.h>
+#include <glm/glm.hpp>
 
 class Shader {
 public:
@@ -14,6 +15,7 @@ public:
     void use();
     void setInt(const std::string &name, int value);
     void setFloat(const std::string &name, float value);
+    void setVec2(const std::string &name, const glm::vec2 &value);
     
 protected:
     GLuint loadShaders(const char* vertex_path, const char* fragment_path);
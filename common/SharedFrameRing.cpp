@@ -0,0 +1,310 @@
+﻿#include "SharedFrameRing.hpp"
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <new>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+const size_t kAlignment = 64;
+
+size_t alignUp(size_t value) {
+    return (value + kAlignment - 1) / kAlignment * kAlignment;
+}
+
+SharedFrameSlotHeader* slotAt(const SharedFrameRingHeader* header, uint64_t index) {
+    char* base = (char*)header + alignUp(sizeof(SharedFrameRingHeader));
+    return (SharedFrameSlotHeader*)(base + index * header->slotStride);
+}
+
+unsigned char* slotData(const SharedFrameSlotHeader* slot) {
+    return (unsigned char*)slot + alignUp(sizeof(SharedFrameSlotHeader));
+}
+
+#ifdef _WIN32
+std::string mappingName(const std::string& name) {
+    return "Local\\" + name;
+}
+#else
+std::string mappingName(const std::string& name) {
+    return name.empty() || name[0] != '/' ? "/" + name : name;
+}
+#endif
+
+void* mapShared(const std::string& name, size_t& bytes, bool create, void** handle) {
+#ifdef _WIN32
+    HANDLE mapping;
+    if (create) {
+        mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+                                     (DWORD)((uint64_t)bytes >> 32), (DWORD)bytes,
+                                     mappingName(name).c_str());
+    } else {
+        mapping = OpenFileMappingA(FILE_MAP_READ, FALSE, mappingName(name).c_str());
+    }
+    if (!mapping) return nullptr;
+
+    void* ptr = MapViewOfFile(mapping, create ? FILE_MAP_ALL_ACCESS : FILE_MAP_READ, 0, 0, create ? bytes : 0);
+    if (!ptr) {
+        CloseHandle(mapping);
+        return nullptr;
+    }
+    if (!create) {
+        MEMORY_BASIC_INFORMATION info;
+        VirtualQuery(ptr, &info, sizeof(info));
+        bytes = info.RegionSize;
+    }
+    *handle = mapping;
+    return ptr;
+#else
+    *handle = nullptr;
+    std::string path = mappingName(name);
+    int fd;
+    if (create) {
+        shm_unlink(path.c_str());
+        fd = shm_open(path.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        if (fd < 0) return nullptr;
+        if (ftruncate(fd, (off_t)bytes) != 0) {
+            ::close(fd);
+            shm_unlink(path.c_str());
+            return nullptr;
+        }
+    } else {
+        fd = shm_open(path.c_str(), O_RDONLY, 0);
+        if (fd < 0) return nullptr;
+        struct stat info;
+        if (fstat(fd, &info) != 0) {
+            ::close(fd);
+            return nullptr;
+        }
+        bytes = (size_t)info.st_size;
+    }
+
+    void* ptr = mmap(nullptr, bytes, create ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    return ptr == MAP_FAILED ? nullptr : ptr;
+#endif
+}
+
+void unmapShared(const void* ptr, size_t bytes, void* handle) {
+#ifdef _WIN32
+    (void)bytes;
+    UnmapViewOfFile(ptr);
+    CloseHandle((HANDLE)handle);
+#else
+    (void)handle;
+    munmap((void*)ptr, bytes);
+#endif
+}
+
+} // namespace
+
+// --- SharedFrameRing ---
+
+int64_t SharedFrameRing::nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+uint64_t SharedFrameRing::slotStride(uint32_t slotCapacity) {
+    return alignUp(sizeof(SharedFrameSlotHeader)) + alignUp(slotCapacity);
+}
+
+size_t SharedFrameRing::mappingSize(uint32_t slotCount, uint32_t slotCapacity) {
+    return alignUp(sizeof(SharedFrameRingHeader)) + (size_t)slotCount * slotStride(slotCapacity);
+}
+
+// --- SharedFramePublisher ---
+
+SharedFramePublisher::SharedFramePublisher()
+    : header(nullptr), mappedBytes(0), framesPublished(0), mappingHandle(nullptr) {}
+
+SharedFramePublisher::~SharedFramePublisher() {
+    close();
+}
+
+bool SharedFramePublisher::open(const std::string& ringName, uint32_t slotCount, uint32_t slotCapacity) {
+    close();
+    if (slotCount == 0) return false;
+
+    size_t bytes = SharedFrameRing::mappingSize(slotCount, slotCapacity);
+    void* memory = mapShared(ringName, bytes, true, &mappingHandle);
+    if (!memory) {
+        std::cerr << "Failed to create shared memory ring: " << ringName << std::endl;
+        return false;
+    }
+
+    name = ringName;
+    mappedBytes = bytes;
+    framesPublished = 0;
+
+    header = new (memory) SharedFrameRingHeader();
+    header->slotCount = slotCount;
+    header->slotCapacity = slotCapacity;
+    header->slotStride = SharedFrameRing::slotStride(slotCapacity);
+    header->generation = (uint64_t)SharedFrameRing::nowNs();
+    header->latest.store(0, std::memory_order_relaxed);
+    for (uint32_t i = 0; i < slotCount; i++) {
+        SharedFrameSlotHeader* slot = new (slotAt(header, i)) SharedFrameSlotHeader();
+        slot->sequence.store(0, std::memory_order_relaxed);
+    }
+    header->version = SharedFrameRing::kVersion;
+    // Publish the magic last so readers never attach to a half-built ring
+    std::atomic_thread_fence(std::memory_order_release);
+    header->magic = SharedFrameRing::kMagic;
+    return true;
+}
+
+void SharedFramePublisher::close() {
+    if (!header) return;
+    unmapShared(header, mappedBytes, mappingHandle);
+#ifndef _WIN32
+    shm_unlink(mappingName(name).c_str());
+#endif
+    header = nullptr;
+    mappingHandle = nullptr;
+}
+
+bool SharedFramePublisher::publish(const unsigned char* data, uint32_t width, uint32_t height,
+                                   uint32_t stride, SharedFrameFormat format, uint32_t flags) {
+    if (!header) return false;
+    uint64_t bytes = (uint64_t)stride * height;
+    if (bytes > header->slotCapacity) return false;
+
+    uint64_t frame = framesPublished + 1;
+    SharedFrameSlotHeader* slot = slotAt(header, (frame - 1) % header->slotCount);
+
+    // Odd counter: readers that started on this slot will fail validation
+    slot->sequence.store(2 * frame - 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot->frameNumber = frame;
+    slot->timestampNs = SharedFrameRing::nowNs();
+    slot->width = width;
+    slot->height = height;
+    slot->stride = stride;
+    slot->format = format;
+    slot->flags = flags;
+    slot->bytes = (uint32_t)bytes;
+    memcpy(slotData(slot), data, (size_t)bytes);
+
+    slot->sequence.store(2 * frame, std::memory_order_release);
+    header->latest.store(frame, std::memory_order_release);
+    framesPublished = frame;
+    return true;
+}
+
+// --- SharedFrameReader ---
+
+SharedFrameReader::SharedFrameReader()
+    : header(nullptr), mappedBytes(0), lastFrameNumber(0), generation(0), mappingHandle(nullptr) {}
+
+SharedFrameReader::~SharedFrameReader() {
+    close();
+}
+
+bool SharedFrameReader::open(const std::string& ringName) {
+    close();
+    size_t bytes = 0;
+    void* memory = mapShared(ringName, bytes, false, &mappingHandle);
+    if (!memory) return false;
+
+    const SharedFrameRingHeader* ring = (const SharedFrameRingHeader*)memory;
+    bool valid = bytes >= sizeof(SharedFrameRingHeader) && ring->magic == SharedFrameRing::kMagic;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (!valid || ring->version != SharedFrameRing::kVersion ||
+        bytes < SharedFrameRing::mappingSize(ring->slotCount, ring->slotCapacity)) {
+        unmapShared(memory, bytes, mappingHandle);
+        mappingHandle = nullptr;
+        return false;
+    }
+
+    name = ringName;
+    header = ring;
+    mappedBytes = bytes;
+    lastFrameNumber = 0;
+    generation = ring->generation;
+    return true;
+}
+
+void SharedFrameReader::close() {
+    if (!header) return;
+    unmapShared(header, mappedBytes, mappingHandle);
+    header = nullptr;
+    mappingHandle = nullptr;
+}
+
+bool SharedFrameReader::acquireLatest(FrameView& view) {
+    if (!header) return false;
+
+    // Retry a few times if the newest slot is already being overwritten
+    for (uint32_t attempt = 0; attempt < header->slotCount; attempt++) {
+        uint64_t latest = header->latest.load(std::memory_order_acquire);
+        if (latest == 0 || latest == lastFrameNumber) return false;
+
+        const SharedFrameSlotHeader* slot = slotAt(header, (latest - 1) % header->slotCount);
+        uint64_t sequence = slot->sequence.load(std::memory_order_acquire);
+        if (sequence != 2 * latest) continue;
+
+        view.slot = slot;
+        view.sequence = sequence;
+        view.data = slotData(slot);
+        view.frameNumber = slot->frameNumber;
+        view.timestampNs = slot->timestampNs;
+        view.width = slot->width;
+        view.height = slot->height;
+        view.stride = slot->stride;
+        view.format = slot->format;
+        view.flags = slot->flags;
+        // Never let a torn header point a reader outside the slot
+        view.bytes = slot->bytes <= header->slotCapacity ? slot->bytes : header->slotCapacity;
+
+        lastFrameNumber = latest;
+        return true;
+    }
+    return false;
+}
+
+bool SharedFrameReader::validate(const FrameView& view) const {
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return view.slot->sequence.load(std::memory_order_relaxed) == view.sequence;
+}
+
+uint64_t SharedFrameReader::latestFrameNumber() const {
+    return header ? header->latest.load(std::memory_order_acquire) : 0;
+}
+
+bool SharedFrameReader::reattachIfReplaced() {
+    if (name.empty()) return false;
+
+    // Rebuilt in place (a Windows mapping stays alive while we hold it)
+    if (header && header->generation != generation) {
+        std::atomic_thread_fence(std::memory_order_acquire);
+        generation = header->generation;
+        lastFrameNumber = 0;
+        return true;
+    }
+
+    SharedFrameReader fresh;
+    if (!fresh.open(name) || (header && fresh.generation == generation)) return false;
+
+    close();
+    header = fresh.header;
+    mappedBytes = fresh.mappedBytes;
+    mappingHandle = fresh.mappingHandle;
+    generation = fresh.generation;
+    lastFrameNumber = 0;
+    fresh.header = nullptr;
+    return true;
+}
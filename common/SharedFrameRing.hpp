@@ -0,0 +1,142 @@
+﻿#ifndef SHAREDFRAMERING_HPP
+#define SHAREDFRAMERING_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Shared-memory ring of fixed-size frame slots for handing processed frames
+// to other processes on the same host.
+//
+// Protocol: one publisher, any number of readers, no locks. Each slot has a
+// seqlock counter which is odd while the publisher writes the slot and
+// 2 * frameNumber once the frame is complete. Readers look at the ring's
+// 'latest' counter, read the slot's pixels in place and then check the
+// counter again; if it moved, the slot was overwritten under them and the
+// frame is discarded. Readers never write to the shared memory, so a slow
+// reader can't hold up the publisher; it just loses frames.
+//
+// A restarted publisher replaces the ring under the same name with a new
+// generation. Readers keep the old mapping until they call
+// reattachIfReplaced(), typically after no new frame arrived for a while.
+
+enum SharedFrameFormat : uint32_t {
+    SHARED_FRAME_BGR8 = 1,
+    SHARED_FRAME_RGB8 = 2,
+    SHARED_FRAME_RGBA8 = 3
+};
+
+enum SharedFrameFlags : uint32_t {
+    SHARED_FRAME_BOTTOM_UP = 1   // first row in memory is the bottom image row
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free,
+              "shared-memory seqlock needs lock-free 64-bit atomics");
+
+struct SharedFrameSlotHeader {
+    std::atomic<uint64_t> sequence;
+    uint64_t frameNumber;     // 1-based, monotonically increasing
+    int64_t timestampNs;      // SharedFrameRing::nowNs() when publishing started
+    uint32_t width;
+    uint32_t height;
+    uint32_t stride;          // bytes per row
+    uint32_t format;          // SharedFrameFormat
+    uint32_t flags;           // SharedFrameFlags
+    uint32_t bytes;           // stride * height
+};
+
+struct SharedFrameRingHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t slotCount;
+    uint32_t slotCapacity;    // pixel bytes available per slot
+    uint64_t slotStride;      // bytes from one slot header to the next
+    uint64_t generation;      // unique per ring instance (creation time)
+    std::atomic<uint64_t> latest;   // frame number of the newest complete frame
+};
+
+class SharedFrameRing {
+public:
+    static const uint32_t kMagic = 0x52465056;   // "VPFR"
+    static const uint32_t kVersion = 2;
+
+    // Monotonic clock shared by all processes on the host
+    static int64_t nowNs();
+    static size_t mappingSize(uint32_t slotCount, uint32_t slotCapacity);
+    static uint64_t slotStride(uint32_t slotCapacity);
+};
+
+class SharedFramePublisher {
+public:
+    SharedFramePublisher();
+    ~SharedFramePublisher();
+
+    // Creates (or replaces) the shared-memory ring. Slots must be large
+    // enough for the biggest frame that will be published.
+    bool open(const std::string& name, uint32_t slotCount, uint32_t slotCapacity);
+    void close();
+    bool isOpen() const { return header != nullptr; }
+
+    // Copies one frame into the next slot; never waits for readers.
+    // Returns false if the frame doesn't fit in a slot.
+    bool publish(const unsigned char* data, uint32_t width, uint32_t height, uint32_t stride,
+                 SharedFrameFormat format, uint32_t flags = 0);
+
+    uint64_t getFramesPublished() const { return framesPublished; }
+
+private:
+    std::string name;
+    SharedFrameRingHeader* header;
+    size_t mappedBytes;
+    uint64_t framesPublished;
+    void* mappingHandle;   // Windows file mapping handle
+};
+
+class SharedFrameReader {
+public:
+    struct FrameView {
+        const unsigned char* data;   // points into shared memory
+        uint64_t frameNumber;
+        int64_t timestampNs;
+        uint32_t width;
+        uint32_t height;
+        uint32_t stride;
+        uint32_t format;
+        uint32_t flags;
+        uint32_t bytes;
+        uint64_t sequence;           // slot counter when acquired
+        const SharedFrameSlotHeader* slot;
+    };
+
+    SharedFrameReader();
+    ~SharedFrameReader();
+
+    bool open(const std::string& name);
+    void close();
+    bool isOpen() const { return header != nullptr; }
+
+    // Newest complete frame not returned before. The view reads the slot in
+    // place; call validate() once done with it.
+    bool acquireLatest(FrameView& view);
+    // True if the slot was not overwritten while the view was in use
+    bool validate(const FrameView& view) const;
+
+    uint64_t latestFrameNumber() const;
+
+    // Re-opens the ring by name and switches to it if the publisher has
+    // created a new one since open() (or rebuilt this one in place). Returns
+    // true if the reader now follows a new ring; frame numbers restart at 1.
+    // Costs a shm open, so call it only when frames have stopped arriving.
+    bool reattachIfReplaced();
+
+private:
+    std::string name;
+    const SharedFrameRingHeader* header;
+    size_t mappedBytes;
+    uint64_t lastFrameNumber;
+    uint64_t generation;
+    void* mappingHandle;
+};
+
+#endif
@@ -0,0 +1,53 @@
+﻿#include "TemporalPass.hpp"
+
+TemporalPass::TemporalPass(const char* vertex_path, const char* fragment_path, ResourcePool* pool)
+    : pool(pool), target(nullptr), accumulators{nullptr, nullptr}, currentAccumulator(0) {
+    shader = new Shader(vertex_path, fragment_path);
+    quad = new FullscreenQuad();
+}
+
+TemporalPass::~TemporalPass() {
+    delete shader;
+    delete quad;
+    delete target;
+    delete accumulators[0];
+    delete accumulators[1];
+}
+
+Texture* TemporalPass::apply(FrameHistory* history, TemporalOperation operation) {
+    int width = history->getWidth();
+    int height = history->getHeight();
+    FrameBuffer* output;
+    if (operation == TEMPORAL_EMA) {
+        // Read the previous accumulator, write the other one
+        for (FrameBuffer*& accumulator : accumulators) {
+            if (!accumulator) accumulator = new FrameBuffer(width, height, pool, GL_RGBA16F);
+            accumulator->resize(width, height);
+        }
+        glActiveTexture(GL_TEXTURE1);
+        accumulators[currentAccumulator]->getTexture()->bind();
+        currentAccumulator = 1 - currentAccumulator;
+        output = accumulators[currentAccumulator];
+    } else {
+        if (!target) target = new FrameBuffer(width, height, pool);
+        target->resize(width, height);
+        output = target;
+    }
+
+    FrameBufferScope scope(output);
+    shader->use();
+    glActiveTexture(GL_TEXTURE0);
+    history->bind();
+    shader->setInt("historySampler", 0);
+    shader->setInt("accumulatorSampler", 1);
+    shader->setInt("uRestart", history->getFrameCount() <= 1);
+    shader->setInt("uLayers", history->getLayerCount());
+    shader->setInt("uCount", history->getFrameCount());
+    shader->setInt("uNewest", history->getNewestLayer());
+    shader->setInt("uOperation", (int)operation);
+    shader->setFloat("uAlpha", emaAlpha);
+    shader->setFloat("uThreshold", motionThreshold);
+    quad->draw();
+
+    return output->getTexture();
+}
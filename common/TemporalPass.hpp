@@ -0,0 +1,43 @@
+﻿#ifndef TEMPORALPASS_HPP
+#define TEMPORALPASS_HPP
+
+#include "Shader.hpp"
+#include "Texture.hpp"
+#include "FrameBuffer.hpp"
+#include "FullscreenQuad.hpp"
+#include "FrameHistory.hpp"
+
+enum TemporalOperation {
+    TEMPORAL_DENOISE,      // mean of the stored frames
+    TEMPORAL_MOTION_MASK,  // |newest - previous| luma above a threshold
+    TEMPORAL_EMA           // running average: acc = alpha * newest + (1 - alpha) * acc
+};
+
+// Combines the frames in a FrameHistory into one output texture. The
+// history is read in place from the texture array; nothing is re-uploaded.
+// The EMA keeps its own accumulator in a pair of half-float targets that are
+// swapped every frame, so it costs one blend per pixel however long it runs.
+class TemporalPass {
+public:
+    TemporalPass(const char* vertex_path, const char* fragment_path, ResourcePool* pool = nullptr);
+    ~TemporalPass();
+
+    // Returns the result texture, owned by the pass (or its pool) and valid
+    // until the next call. Call once per pushed frame: the EMA blends in the
+    // newest frame on every call and restarts from it when the history holds
+    // a single frame (after a reset or a size change).
+    Texture* apply(FrameHistory* history, TemporalOperation operation);
+
+    float emaAlpha = 0.25f;
+    float motionThreshold = 25.0f / 255.0f;
+
+private:
+    ResourcePool* pool;
+    Shader* shader;
+    FullscreenQuad* quad;
+    FrameBuffer* target;
+    FrameBuffer* accumulators[2];
+    int currentAccumulator;
+};
+
+#endif
@@ -1,11 +1,13 @@
 ﻿#include "Texture.hpp"
 
-Texture::Texture(unsigned char* data, int width, int height, bool rgb) {
+Texture::Texture(unsigned char* data, int width, int height, bool rgb, GLint internalFormat)
+    : width(width), height(height), rgb(rgb),
+      internalFormat(internalFormat ? internalFormat : (rgb ? GL_RGB8 : GL_RGBA8)) {
     glGenTextures(1, &textureID);
     glBindTexture(GL_TEXTURE_2D, textureID);
     
     GLenum format = rgb ? GL_RGB : GL_RGBA;
-    glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
+    glTexImage2D(GL_TEXTURE_2D, 0, this->internalFormat, width, height, 0, format, GL_UNSIGNED_BYTE, data);
     
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
@@ -17,9 +19,17 @@ Texture::~Texture() {
     glDeleteTextures(1, &textureID);
 }
 
-void Texture::update(unsigned char* data, int width, int height, bool rgb) {
+void Texture::update(unsigned char* data, int newWidth, int newHeight, bool newRgb) {
     glBindTexture(GL_TEXTURE_2D, textureID);
-    GLenum format = rgb ? GL_RGB : GL_RGBA;
+    GLenum format = newRgb ? GL_RGB : GL_RGBA;
+    if (newWidth != width || newHeight != height || newRgb != rgb) {
+        width = newWidth;
+        height = newHeight;
+        if (newRgb != rgb) internalFormat = newRgb ? GL_RGB8 : GL_RGBA8;
+        rgb = newRgb;
+        glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0, format, GL_UNSIGNED_BYTE, data);
+        return;
+    }
     glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, format, GL_UNSIGNED_BYTE, data);
 }
 
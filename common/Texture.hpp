@@ -7,11 +7,23 @@ class Texture {
 public:
     GLuint textureID;
     
-    Texture(unsigned char* data, int width, int height, bool rgb);
+    // internalFormat defaults to GL_RGB8 / GL_RGBA8; render targets may ask
+    // for more precision (e.g. GL_RGBA16F)
+    Texture(unsigned char* data, int width, int height, bool rgb, GLint internalFormat = 0);
     ~Texture();
     
+    // Reallocates the texture storage if the size or format changed
     void update(unsigned char* data, int width, int height, bool rgb);
     void bind();
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+
+private:
+    int width;
+    int height;
+    bool rgb;
+    GLint internalFormat;
 };
 
 #endif
@@ -0,0 +1,117 @@
+﻿#include "Trace.hpp"
+
+#ifdef ENABLE_TRACING
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+struct TraceEvent {
+    const char* name;
+    int64_t startNs;
+    int64_t durationNs;
+};
+
+// Written only by its owning thread; read by dump() up to the published count
+struct ThreadBuffer {
+    uint32_t tid = 0;
+    std::string name;
+    std::unique_ptr<TraceEvent[]> events;
+    std::atomic<uint64_t> count{0};
+};
+
+// Buffers are never freed so dump() stays valid after a thread exits
+std::mutex registryMutex;
+std::vector<std::unique_ptr<ThreadBuffer>> registry;
+const auto traceEpoch = std::chrono::steady_clock::now();
+
+ThreadBuffer* localBuffer() {
+    thread_local ThreadBuffer* buffer = nullptr;
+    if (!buffer) {
+        auto created = std::make_unique<ThreadBuffer>();
+        created->events.reset(new TraceEvent[Trace::kEventsPerThread]);
+
+        std::lock_guard<std::mutex> lock(registryMutex);
+        created->tid = (uint32_t)registry.size() + 1;
+        created->name = "thread " + std::to_string(created->tid);
+        buffer = created.get();
+        registry.push_back(std::move(created));
+    }
+    return buffer;
+}
+
+void writeEscaped(std::ostream& out, const std::string& s) {
+    for (char c : s) {
+        if (c == '"' || c == '\\') out << '\\';
+        out << c;
+    }
+}
+
+} // namespace
+
+int64_t Trace::nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - traceEpoch).count();
+}
+
+void Trace::record(const char* name, int64_t startNs, int64_t endNs) {
+    ThreadBuffer* buffer = localBuffer();
+    uint64_t index = buffer->count.load(std::memory_order_relaxed);
+    buffer->events[index & (kEventsPerThread - 1)] = { name, startNs, endNs - startNs };
+    buffer->count.store(index + 1, std::memory_order_release);
+}
+
+void Trace::setThreadName(const char* name) {
+    ThreadBuffer* buffer = localBuffer();
+    std::lock_guard<std::mutex> lock(registryMutex);
+    buffer->name = name;
+}
+
+bool Trace::dump(const std::string& path) {
+    std::ofstream out(path);
+    if (!out.is_open()) {
+        std::cerr << "Failed to open trace file: " << path << std::endl;
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(registryMutex);
+    size_t totalEvents = 0;
+    bool first = true;
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+    for (const auto& buffer : registry) {
+        out << (first ? "\n" : ",\n");
+        first = false;
+        out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->tid
+            << ",\"args\":{\"name\":\"";
+        writeEscaped(out, buffer->name);
+        out << "\"}}";
+
+        // Spans recorded while dumping from another thread may be skipped; dump
+        // from the render thread or at exit for a complete trace
+        uint64_t count = buffer->count.load(std::memory_order_acquire);
+        uint64_t begin = count > kEventsPerThread ? count - kEventsPerThread : 0;
+        for (uint64_t i = begin; i < count; ++i) {
+            const TraceEvent& e = buffer->events[i & (kEventsPerThread - 1)];
+            out << ",\n{\"name\":\"";
+            writeEscaped(out, e.name);
+            out << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->tid
+                << ",\"ts\":" << e.startNs / 1000 << "." << (e.startNs % 1000) / 100
+                << ",\"dur\":" << e.durationNs / 1000 << "." << (e.durationNs % 1000) / 100
+                << "}";
+        }
+        totalEvents += (size_t)(count - begin);
+    }
+    out << "\n]}\n";
+
+    std::cout << "Trace written to " << path << " (" << totalEvents << " spans)" << std::endl;
+    return true;
+}
+
+#endif
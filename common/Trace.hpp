@@ -0,0 +1,59 @@
+﻿#ifndef TRACE_HPP
+#define TRACE_HPP
+
+#include <string>
+
+// Scoped frame-pipeline tracing, exported as Chrome trace-event JSON
+// (open in https://ui.perfetto.dev or chrome://tracing).
+//
+// Each thread records into its own fixed-size ring buffer, so recording a
+// span never takes a lock. Build with -DENABLE_TRACING=ON to compile it in;
+// otherwise TRACE_SCOPE expands to nothing and dump() is a no-op.
+
+#ifdef ENABLE_TRACING
+
+#include <cstdint>
+
+class Trace {
+public:
+    // Events kept per thread; older events are overwritten once full
+    static const uint32_t kEventsPerThread = 1u << 16;
+
+    static int64_t nowNs();
+    static void record(const char* name, int64_t startNs, int64_t endNs);
+    static void setThreadName(const char* name);
+
+    // Writes every recorded span to a Chrome trace-event JSON file
+    static bool dump(const std::string& path);
+};
+
+class TraceScope {
+public:
+    explicit TraceScope(const char* name) : name(name), startNs(Trace::nowNs()) {}
+    ~TraceScope() { Trace::record(name, startNs, Trace::nowNs()); }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* name;   // must be a string literal (stored by pointer)
+    int64_t startNs;
+};
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+#define TRACE_SCOPE(name) TraceScope TRACE_CONCAT(traceScope_, __LINE__)(name)
+
+#else
+
+class Trace {
+public:
+    static void setThreadName(const char*) {}
+    static bool dump(const std::string&) { return false; }
+};
+
+#define TRACE_SCOPE(name) ((void)0)
+
+#endif
+
+#endif
@@ -3,11 +3,25 @@
  *
  * FEATURES:
  * - Live camera feed rendering
- * - Multiple filters (Pixelation, Grayscale) with CPU/GPU implementations
+ * - Multiple filters (Pixelation, Grayscale, Box/Gaussian Blur) with CPU/GPU implementations
+ * - Temporal filters (denoise, motion mask, EMA) over a history of recent frames,
+ *   kept in a GPU texture array or a preallocated CPU ring
  * - Interactive geometric transformations (translate, rotate, scale)
  * - Runtime switching between filters and processing modes
  * - Performance measurement for experimental analysis
  * - 60-second average FPS logging
+ * - Optional Chrome/Perfetto trace export of the frame pipeline (ENABLE_TRACING)
+ * - Pooled allocator for frame-sized cv::Mat buffers (page fault / RSS reporting)
+ * - Blur radius sweep benchmark (CPU running-sum vs. GPU separable passes)
+ * - Headless EGL rendering into an offscreen framebuffer (--headless)
+ * - Processed frames published to a shared-memory ring for local consumers (--shm)
+ * - Runtime resolution switching (480p-4K) over pooled textures, upload buffers and
+ *   CPU frame buffers, with per-resolution FPS / upload bandwidth logging
+ *
+ * USAGE:
+ *   VideoProcessing [--input <video file>] [--cpu] [--no-pool] [--filter <1-8>]
+ *                   [--headless [--frames <count>]] [--shm <name> [--shm-slots <n>]]
+ *                   [--resolution <480p|720p|1080p|4K>] [--sweep-resolutions]
  */
 
 #include <stdio.h>
@@ -16,6 +30,11 @@
 #include <iostream>
 #include <chrono>
 #include <vector>
+#include <algorithm>
+#include <map>
+#include <tuple>
+#include <utility>
+#include <cmath>
 
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
@@ -33,13 +52,65 @@
 #include <common/TextureShader.hpp>
 #include <common/Quad.hpp>
 #include <common/Texture.hpp>
+#include <common/Trace.hpp>
+#include <common/PooledMatAllocator.hpp>
+#include <common/BlurCPU.hpp>
+#include <common/BlurPass.hpp>
+#include <common/FrameHistory.hpp>
+#include <common/FrameHistoryCPU.hpp>
+#include <common/TemporalPass.hpp>
+#include <common/SharedFrameRing.hpp>
+#include <common/PixelReadback.hpp>
+#include <common/OutputPass.hpp>
+#include <common/GpuTimer.hpp>
+#include <common/ResourcePool.hpp>
+#ifdef HAVE_EGL
+#include <common/OffscreenContext.hpp>
+#endif
 
 using namespace std;
 using namespace glm;
 GLFWwindow* window;
 
+const int kWindowWidth = 1024;
+const int kWindowHeight = 768;
+const int kHistoryFrames = 8;   // frames kept for temporal filters
+const uint32_t kSharedSlotBytes = 5040 * 2160 * 3;   // largest frame published (4K BGR, up to 21:9)
+
+// --- Processing resolutions (F1-F4) ---
+// A preset fixes the frame height; the width follows the source aspect ratio
+// (see presetSize), so 16:9 input at 480p is processed at 854x480. The width
+// here is only what the camera is asked for.
+struct ResolutionPreset {
+    const char* name;
+    int width;
+    int height;
+};
+const ResolutionPreset kResolutions[] = {
+    { "480p", 640, 480 },
+    { "720p", 1280, 720 },
+    { "1080p", 1920, 1080 },
+    { "4K", 3840, 2160 }
+};
+const int kResolutionCount = sizeof(kResolutions) / sizeof(kResolutions[0]);
+const int kCameraResolution = 1;                // camera starts at 720p
+const int kResolutionWarmupFrames = 10;         // not counted after a size change
+const double kSweepSecondsPerResolution = 10.0;
+
+// --- Command line options ---
+struct LaunchOptions {
+    std::string inputPath;      // video file instead of camera 0 (looped)
+    bool headless = false;      // render offscreen through EGL, no window
+    int headlessFrames = 600;   // frames to render before exiting headless runs
+    std::string shmName;        // publish processed frames to this shared-memory ring
+    int shmSlots = 4;
+    int resolution = -1;        // preset index, -1 = camera default / video file size
+    bool sweepResolutions = false;
+};
+
 // --- Global state for interaction ---
-enum FilterMode { FILTER_NONE, FILTER_PIXELATE, FILTER_GRAYSCALE };
+enum FilterMode { FILTER_NONE, FILTER_PIXELATE, FILTER_GRAYSCALE, FILTER_BOX_BLUR, FILTER_GAUSSIAN_BLUR,
+                  FILTER_TEMPORAL_DENOISE, FILTER_MOTION_MASK, FILTER_EMA };
 enum ProcessingMode { CPU_MODE, GPU_MODE };
 
 struct AppState {
@@ -50,6 +121,17 @@ struct AppState {
     float rotation = 0.0f;
     float scale = 1.0f;
 
+    int blurRadius = 8;
+    bool runBlurBenchmark = false;
+
+    bool usePooledAllocator = true;
+
+    // Processing resolution; frames the source delivers at another size are resized
+    int resolution = -1;            // index into kResolutions, -1 = source size
+    bool resolutionChanged = false;
+    bool sweepResolutions = false;  // step through every preset, then report
+    std::chrono::high_resolution_clock::time_point resolutionStart;
+
     bool isDragging = false;
     glm::vec2 lastMousePos;
 
@@ -60,17 +142,51 @@ struct AppState {
     std::vector<double> allFrameTimes;
     bool logged60SecAverage = false;
     std::chrono::high_resolution_clock::time_point startTime;
+    uint64_t pageFaultsAtStart = 0;
+    // Current RSS sampled once per reporting window (peak RSS can't be reset)
+    size_t residentMax = 0;
+    double residentSum = 0.0;
+    int residentSamples = 0;
+
+    void sampleResident() {
+        size_t resident = ProcessMemoryInfo::query().residentBytes;
+        residentMax = std::max(residentMax, resident);
+        residentSum += (double)resident;
+        residentSamples++;
+    }
+
+    // Per filter, mode and frame size, for the resolution scaling report;
+    // switching filter or mode starts a new curve and keeps the others
+    typedef std::tuple<int, int, int, int> ResolutionKey;   // filter, mode, width, height
+    struct ResolutionStats {
+        uint64_t frames = 0;
+        double frameMs = 0.0;
+        double copyMs = 0.0;          // CPU side of the upload (copy into the PBO, submit)
+        uint64_t gpuUploads = 0;      // frames with a GPU upload time
+        double gpuUploadMs = 0.0;     // GL_TIME_ELAPSED around the upload
+        uint64_t gpuUploadBytes = 0;
+    };
+    std::map<ResolutionKey, ResolutionStats> resolutionStats;
+    ResolutionKey statsKey{ -1, -1, 0, 0 };   // key of the frames being recorded
+    cv::Size frameSize;
+    int framesAtSize = 0;
     
     void resetFPSTracking() {
         allFrameTimes.clear();
         logged60SecAverage = false;
         startTime = std::chrono::high_resolution_clock::now();
+        pageFaultsAtStart = ProcessMemoryInfo::query().pageFaults;
+        residentMax = 0;
+        residentSum = 0.0;
+        residentSamples = 0;
+        PooledMatAllocator::instance().resetStats();
     }
 };
 
 AppState appState;
 
 // --- Helper functions ---
+bool parseArguments(int argc, char** argv, LaunchOptions& options);
 bool initWindow(std::string windowName);
 void keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods);
 void mouseButtonCallback(GLFWwindow* window, int button, int action, int mods);
@@ -78,39 +194,92 @@ void cursorPosCallback(GLFWwindow* window, double xpos, double ypos);
 void scrollCallback(GLFWwindow* window, double xoffset, double yoffset);
 void applyPixelationCPU(cv::Mat& frame, int pixelSize);
 void applyGrayscaleCPU(cv::Mat& frame);
+void setPooledAllocator(bool enabled);
+void printAllocatorReport();
+const char* filterName(FilterMode mode);
+bool isTemporalFilter(FilterMode mode);
+TemporalOperation temporalOperation(FilterMode mode);
+void printAverageFPSReport(const char* title);
+void runBlurBenchmark(const cv::Mat& frame, Texture* sourceTexture, BlurPass* blurPass);
+int findResolution(const std::string& name);
+cv::Size presetSize(const ResolutionPreset& preset, const cv::Size& source);
+void setResolution(int index);
+void restartResolutionSweep();
+void applyResolution(cv::VideoCapture& cap, bool camera);
+bool recordResolutionFrame(const cv::Size& size, double frameMs, double copyMs);
+void recordUploadTime(const AppState::ResolutionKey& key, double gpuMs, uint64_t bytes);
+double uploadBandwidth(const AppState::ResolutionStats& stats);
+void printResolutionSummary(const AppState::ResolutionKey& key);
+void printResolutionReport(const char* title);
 
 // --- Main ---
-int main(void) {
-    // --- Step 1: Open camera ---
-    cv::VideoCapture cap(0);
+int main(int argc, char** argv) {
+    LaunchOptions options;
+    if (!parseArguments(argc, argv, options)) return -1;
+
+    // --- Step 1: Open camera (or video file) ---
+    cv::VideoCapture cap;
+    if (options.inputPath.empty()) cap.open(0);
+    else cap.open(options.inputPath);
     if (!cap.isOpened()) {
-        cerr << "Error: Could not open camera. Exiting." << endl;
+        cerr << "Error: Could not open " << (options.inputPath.empty() ? "camera" : options.inputPath)
+             << ". Exiting." << endl;
         return -1;
     }
     // --- Set camera resolution ---
-    cap.set(cv::CAP_PROP_FRAME_WIDTH, 1280);
-    cap.set(cv::CAP_PROP_FRAME_HEIGHT, 720);
-    cout << "Camera opened successfully." << endl;
+    bool camera = options.inputPath.empty();
+    if (options.resolution < 0 && camera) options.resolution = kCameraResolution;
+    appState.resolution = options.resolution;
+    if (camera) {
+        cout << "Camera opened successfully." << endl;
+    } else {
+        cout << "Video file opened successfully." << endl;
+    }
+    applyResolution(cap, camera);
+    if (options.sweepResolutions) {
+        appState.sweepResolutions = true;
+        setResolution(0);
+    }
+    Trace::setThreadName("render");
+    setPooledAllocator(appState.usePooledAllocator);
 
     // --- Step 2: Initialize OpenGL context ---
-    if (!initWindow("Real-time Video Processing")) return -1;
+#ifdef HAVE_EGL
+    OffscreenContext* offscreen = nullptr;
+    if (options.headless) {
+        offscreen = new OffscreenContext();
+        if (!offscreen->init(kWindowWidth, kWindowHeight)) {
+            delete offscreen;
+            cap.release();
+            return -1;
+        }
+        cout << "Rendering " << options.headlessFrames << " frames offscreen ("
+             << kWindowWidth << "x" << kWindowHeight << ")" << endl;
+    } else
+#endif
+    {
+        if (!initWindow("Real-time Video Processing")) return -1;
 
-    if (!gladLoadGL()) {
-        fprintf(stderr, "Failed to initialize OpenGL context (GLAD)\n");
-        cap.release();
-        return -1;
+        if (!gladLoadGL()) {
+            fprintf(stderr, "Failed to initialize OpenGL context (GLAD)\n");
+            cap.release();
+            return -1;
+        }
+        cout << "Loaded OpenGL " << GLVersion.major << "." << GLVersion.minor << "\n";
+
+        glfwSetInputMode(window, GLFW_STICKY_KEYS, GL_TRUE);
+
+        // --- Set up callbacks ---
+        glfwSetKeyCallback(window, keyCallback);
+        glfwSetMouseButtonCallback(window, mouseButtonCallback);
+        glfwSetCursorPosCallback(window, cursorPosCallback);
+        glfwSetScrollCallback(window, scrollCallback);
     }
-    cout << "Loaded OpenGL " << GLVersion.major << "." << GLVersion.minor << "\n";
 
-    glfwSetInputMode(window, GLFW_STICKY_KEYS, GL_TRUE);
     glClearColor(0.1f, 0.1f, 0.2f, 0.0f);
     glEnable(GL_DEPTH_TEST);
-
-    // --- Set up callbacks ---
-    glfwSetKeyCallback(window, keyCallback);
-    glfwSetMouseButtonCallback(window, mouseButtonCallback);
-    glfwSetCursorPosCallback(window, cursorPosCallback);
-    glfwSetScrollCallback(window, scrollCallback);
+    // Frames of any width are uploaded tightly packed
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
 
     GLuint VertexArrayID;
     glGenVertexArrays(1, &VertexArrayID);
@@ -122,7 +291,7 @@ int main(void) {
     if (frame.empty()) {
         cerr << "Error: Couldn't capture an initial frame. Exiting." << endl;
         cap.release();
-        glfwTerminate();
+        if (!options.headless) glfwTerminate();
         return -1;
     }
 
@@ -141,43 +310,198 @@ int main(void) {
     myQuad->setShader(textureShader);
     myScene->addObject(myQuad);
 
-    Texture* videoTexture = new Texture(frame.data, frame.cols, frame.rows, true);
+    // Textures, upload buffers and CPU frames for every size seen so far
+    ResourcePool* resourcePool = new ResourcePool();
+    Texture* videoTexture = resourcePool->getTexture(frame.cols, frame.rows, true);
+    resourcePool->upload(videoTexture, frame.data, frame.cols, frame.rows, true);
     textureShader->setTexture(videoTexture);
 
+    BlurPass* blurPass = new BlurPass("shaders/fullscreenQuad.vert", "shaders/blurShader.frag", resourcePool);
+
+    FrameHistory* gpuHistory = new FrameHistory(kHistoryFrames, resourcePool);
+    FrameHistoryCPU cpuHistory(kHistoryFrames, resourcePool);
+    TemporalPass* temporalPass = new TemporalPass("shaders/fullscreenQuad.vert", "shaders/temporalShader.frag",
+                                                 resourcePool);
+    FilterMode historyFilter = appState.currentFilter;
+    ProcessingMode historyMode = appState.processingMode;
+
+    // CPU output is published directly; GPU output is rendered at frame size
+    // and goes through an async readback
+    SharedFramePublisher* framePublisher = nullptr;
+    PixelReadback* readback = nullptr;
+    OutputPass* outputPass = nullptr;
+    if (!options.shmName.empty()) {
+        framePublisher = new SharedFramePublisher();
+        if (framePublisher->open(options.shmName, options.shmSlots, kSharedSlotBytes)) {
+            readback = new PixelReadback();
+            outputPass = new OutputPass("shaders/fullscreenQuad.vert", "shaders/videoTextureShader.frag",
+                                        resourcePool);
+            cout << "Publishing frames to shared memory '" << options.shmName << "' ("
+                 << options.shmSlots << " slots)" << endl;
+        } else {
+            delete framePublisher;
+            framePublisher = nullptr;
+        }
+    }
+
     // --- Controls info ---
-    cout << "\n=== CONTROLS ===" << endl;
-    cout << "1: No filter" << endl;
-    cout << "2: Pixelation filter" << endl;
-    cout << "3: Grayscale filter" << endl;
-    cout << "C: Toggle CPU/GPU mode" << endl;
-    cout << "Mouse drag: Translate" << endl;
-    cout << "Mouse scroll: Scale" << endl;
-    cout << "Hold R + drag: Rotate" << endl;
-    cout << "Space: Reset transformations" << endl;
-    cout << "ESC: Exit\n" << endl;
+    if (!options.headless) {
+        cout << "\n=== CONTROLS ===" << endl;
+        cout << "1: No filter" << endl;
+        cout << "2: Pixelation filter" << endl;
+        cout << "3: Grayscale filter" << endl;
+        cout << "4: Box blur filter" << endl;
+        cout << "5: Gaussian blur filter" << endl;
+        cout << "6: Temporal denoise filter" << endl;
+        cout << "7: Motion mask filter" << endl;
+        cout << "8: Exponential moving average filter" << endl;
+        cout << "[ / ]: Decrease / increase blur radius" << endl;
+        cout << "B: Run blur radius benchmark" << endl;
+        cout << "C: Toggle CPU/GPU mode" << endl;
+        cout << "P: Toggle pooled frame allocator" << endl;
+        cout << "F1-F4: Resolution 480p / 720p / 1080p / 4K" << endl;
+        cout << "V: Sweep all resolutions (" << kSweepSecondsPerResolution << "s each) and report" << endl;
+        cout << "Mouse drag: Translate" << endl;
+        cout << "Mouse scroll: Scale" << endl;
+        cout << "Hold R + drag: Rotate" << endl;
+        cout << "Space: Reset transformations" << endl;
+#ifdef ENABLE_TRACING
+        cout << "T: Dump trace to trace.json" << endl;
+#endif
+        cout << "ESC: Exit\n" << endl;
+    }
+
+    // Intermediate buffer of the CPU blurs, one per frame size
+    cv::Mat blurScratch;
+
+    // Upload GPU times arrive a few frames late; remember which frame each
+    // timed interval belongs to
+    struct TimedUpload {
+        AppState::ResolutionKey key;
+        uint64_t bytes;
+        bool counted;       // false for warm-up frames
+    };
+    GpuTimer* uploadTimer = new GpuTimer();
+    TimedUpload timedUploads[GpuTimer::kQueries] = {};
 
     auto lastTime = std::chrono::high_resolution_clock::now();
-    appState.startTime = std::chrono::high_resolution_clock::now();
+    appState.resetFPSTracking();
 
     // --- Step 4: Main Render Loop ---
-    while (!glfwWindowShouldClose(window)) {
+    while (options.headless ? appState.frameCount < options.headlessFrames || appState.sweepResolutions
+                            : !glfwWindowShouldClose(window)) {
+        TRACE_SCOPE("frame");
         auto frameStart = std::chrono::high_resolution_clock::now();
+        if (appState.resolutionChanged) applyResolution(cap, camera);
+        cv::Size frameSize;
+        double copyMs = 0.0;
+        uint64_t uploadBytes = 0;
+        bool uploadTimed = false;
+#ifdef HAVE_EGL
+        if (offscreen) offscreen->bind();
+#endif
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-        cap >> frame;
-        if (!frame.empty() && videoTexture != nullptr) {
-            cv::Mat processedFrame = frame.clone();
+        {
+            TRACE_SCOPE("capture");
+            cap >> frame;
+            if (frame.empty() && !options.inputPath.empty()) {
+                // Loop video files so long runs keep a steady input
+                cap.set(cv::CAP_PROP_POS_FRAMES, 0);
+                cap >> frame;
+            }
+        }
+        if (!frame.empty()) {
+            cv::Mat processedFrame;
+            {
+                TRACE_SCOPE("copy to pooled frame");
+                frameSize = frame.size();
+                if (appState.resolution >= 0) {
+                    frameSize = presetSize(kResolutions[appState.resolution], frame.size());
+                }
+                processedFrame = resourcePool->getCpuBuffer(frameSize.width, frameSize.height, frame.type());
+                if (frameSize == frame.size()) {
+                    frame.copyTo(processedFrame);
+                } else {
+                    // The source didn't honor the requested size (video files, most cameras at 4K)
+                    cv::resize(frame, processedFrame, frameSize, 0, 0,
+                               frameSize.area() < frame.size().area() ? cv::INTER_AREA : cv::INTER_LINEAR);
+                }
+            }
+            myQuad->setAspectRatio((float)frameSize.width / (float)frameSize.height);
+
+            // Temporal history is only meaningful for the filter it was built for
+            if (appState.currentFilter != historyFilter || appState.processingMode != historyMode) {
+                cpuHistory.reset();
+                gpuHistory->reset();
+                historyFilter = appState.currentFilter;
+                historyMode = appState.processingMode;
+                // Each scaling curve covers one filter and mode: a sweep in
+                // progress starts over so its curve is complete
+                if (appState.sweepResolutions) {
+                    restartResolutionSweep();
+                    cout << "Filter or mode changed, sweep restarted" << endl;
+                }
+            }
 
             if (appState.processingMode == CPU_MODE) {
                 switch (appState.currentFilter) {
-                    case FILTER_PIXELATE: applyPixelationCPU(processedFrame, 10); break;
-                    case FILTER_GRAYSCALE: applyGrayscaleCPU(processedFrame); break;
+                    case FILTER_PIXELATE: {
+                        TRACE_SCOPE("filter: pixelate");
+                        applyPixelationCPU(processedFrame, 10);
+                        break;
+                    }
+                    case FILTER_GRAYSCALE: {
+                        TRACE_SCOPE("filter: grayscale");
+                        applyGrayscaleCPU(processedFrame);
+                        break;
+                    }
+                    case FILTER_BOX_BLUR: {
+                        TRACE_SCOPE("filter: box blur");
+                        blurScratch = resourcePool->getCpuBuffer(processedFrame.cols, processedFrame.rows,
+                                                                 processedFrame.type(), &blurScratch);
+                        applyBoxBlurCPU(processedFrame, appState.blurRadius, blurScratch);
+                        break;
+                    }
+                    case FILTER_GAUSSIAN_BLUR: {
+                        TRACE_SCOPE("filter: gaussian blur");
+                        blurScratch = resourcePool->getCpuBuffer(processedFrame.cols, processedFrame.rows,
+                                                                 processedFrame.type(), &blurScratch);
+                        applyGaussianBlurCPU(processedFrame, appState.blurRadius, blurScratch);
+                        break;
+                    }
+                    case FILTER_TEMPORAL_DENOISE: {
+                        TRACE_SCOPE("filter: temporal denoise");
+                        cpuHistory.push(processedFrame);
+                        cpuHistory.applyDenoise(processedFrame);
+                        break;
+                    }
+                    case FILTER_MOTION_MASK: {
+                        TRACE_SCOPE("filter: motion mask");
+                        cpuHistory.push(processedFrame);
+                        cpuHistory.applyMotionMask(processedFrame, temporalPass->motionThreshold);
+                        break;
+                    }
+                    case FILTER_EMA: {
+                        TRACE_SCOPE("filter: ema");
+                        cpuHistory.push(processedFrame);
+                        cpuHistory.applyEMA(processedFrame, temporalPass->emaAlpha);
+                        break;
+                    }
                     default: break;
                 }
 
+                // Published before the view transform, like the GPU readback below
+                if (framePublisher) {
+                    TRACE_SCOPE("shm publish");
+                    framePublisher->publish(processedFrame.data, processedFrame.cols, processedFrame.rows,
+                                            (uint32_t)processedFrame.step, SHARED_FRAME_BGR8);
+                }
+
                 if (appState.translation != glm::vec2(0.0f) ||
                     appState.rotation != 0.0f ||
                     appState.scale != 1.0f) {
+                    TRACE_SCOPE("warpAffine");
                     cv::Point2f center(processedFrame.cols / 2.0f, processedFrame.rows / 2.0f);
                     cv::Mat transform = cv::getRotationMatrix2D(center, appState.rotation, appState.scale);
 
@@ -190,13 +514,79 @@ int main(void) {
             }
 
             // Flip vertically before sending to GPU
-            cv::flip(processedFrame, processedFrame, 0);
-            cv::cvtColor(processedFrame, processedFrame, cv::COLOR_BGR2RGB);
-            videoTexture->update(processedFrame.data, processedFrame.cols, processedFrame.rows, true);
+            {
+                TRACE_SCOPE("flip");
+                cv::flip(processedFrame, processedFrame, 0);
+            }
+            {
+                TRACE_SCOPE("cvtColor");
+                cv::cvtColor(processedFrame, processedFrame, cv::COLOR_BGR2RGB);
+            }
+            bool gpuTemporal = appState.processingMode == GPU_MODE && isTemporalFilter(appState.currentFilter);
+            {
+                TRACE_SCOPE("texture upload");
+                uploadTimer->begin();
+                auto uploadStart = std::chrono::high_resolution_clock::now();
+                if (gpuTemporal) {
+                    // Written once, straight into the next history layer
+                    gpuHistory->push(processedFrame.data, processedFrame.cols, processedFrame.rows, true);
+                } else {
+                    videoTexture = resourcePool->getTexture(processedFrame.cols, processedFrame.rows, true);
+                    resourcePool->upload(videoTexture, processedFrame.data, processedFrame.cols,
+                                         processedFrame.rows, true);
+                }
+                copyMs = std::chrono::duration<double, std::milli>(
+                    std::chrono::high_resolution_clock::now() - uploadStart).count();
+                uploadTimer->end();
+                uploadTimed = true;
+                uploadBytes = (uint64_t)processedFrame.total() * processedFrame.elemSize();
+            }
+
+            if (appState.runBlurBenchmark) {
+                runBlurBenchmark(processedFrame, videoTexture, blurPass);
+                appState.runBlurBenchmark = false;
+                appState.resetFPSTracking();
+            }
+
+            Texture* displayTexture = videoTexture;
+            bool gpuBlur = appState.processingMode == GPU_MODE &&
+                           (appState.currentFilter == FILTER_BOX_BLUR ||
+                            appState.currentFilter == FILTER_GAUSSIAN_BLUR);
+            if (gpuBlur) {
+                TRACE_SCOPE("filter: gpu blur");
+                displayTexture = blurPass->apply(videoTexture, processedFrame.cols, processedFrame.rows,
+                                                 appState.blurRadius,
+                                                 appState.currentFilter == FILTER_GAUSSIAN_BLUR);
+            } else if (gpuTemporal) {
+                TRACE_SCOPE("filter: gpu temporal");
+                displayTexture = temporalPass->apply(gpuHistory, temporalOperation(appState.currentFilter));
+            }
+
+            if (framePublisher && appState.processingMode == GPU_MODE) {
+                TRACE_SCOPE("shm publish (readback)");
+                // Same frame the CPU path publishes: the filtered frame at processing
+                // resolution, top-down BGR, before the view transform
+                int width = processedFrame.cols;
+                int height = processedFrame.rows;
+                FrameBuffer* output = outputPass->apply(displayTexture, width, height,
+                                                        (gpuBlur || gpuTemporal) ? 0 : (int)appState.currentFilter, 10);
+                const unsigned char* pixels;
+                {
+                    FrameBufferScope scope(output);
+                    pixels = readback->read(width, height);
+                }
+                if (pixels) {
+                    framePublisher->publish(pixels, width, height, width * 3, SHARED_FRAME_BGR8);
+                }
+                readback->release();
+            }
+            textureShader->setTexture(displayTexture);
 
             textureShader->use();
             if (appState.processingMode == GPU_MODE) {
-                textureShader->setInt("filterMode", (int)appState.currentFilter);
+                // Blur and temporal filters ran in their own passes; the display shader
+                // only applies pixelate/grayscale
+                textureShader->setInt("filterMode", (gpuBlur || gpuTemporal) ? 0 : (int)appState.currentFilter);
                 textureShader->setInt("pixelSize", 10);
                 textureShader->setFloat("uTranslateX", appState.translation.x);
                 textureShader->setFloat("uTranslateY", appState.translation.y);
@@ -212,8 +602,23 @@ int main(void) {
         }
 
         myScene->render(renderingCamera);
-        glfwSwapBuffers(window);
-        glfwPollEvents();
+
+#ifdef HAVE_EGL
+        if (offscreen) {
+            TRACE_SCOPE("offscreen present");
+            offscreen->present();
+        } else
+#endif
+        {
+            {
+                TRACE_SCOPE("glfwSwapBuffers");
+                glfwSwapBuffers(window);
+            }
+            {
+                TRACE_SCOPE("glfwPollEvents");
+                glfwPollEvents();
+            }
+        }
 
         // --- Performance tracking ---
         auto frameEnd = std::chrono::high_resolution_clock::now();
@@ -221,37 +626,42 @@ int main(void) {
         appState.frameTimes.push_back(frameDuration.count());
         appState.allFrameTimes.push_back(frameDuration.count());
         appState.frameCount++;
+        bool counted = frameSize.area() > 0 &&
+                       recordResolutionFrame(frameSize, frameDuration.count(), copyMs);
+        if (uploadTimed) {
+            TimedUpload& upload = timedUploads[(uploadTimer->getIntervalCount() - 1) % GpuTimer::kQueries];
+            upload = { appState.statsKey, uploadBytes, counted };
+        }
+        double gpuUploadMs;
+        uint64_t interval;
+        while (uploadTimer->nextResult(gpuUploadMs, interval)) {
+            const TimedUpload& upload = timedUploads[interval % GpuTimer::kQueries];
+            if (upload.counted) recordUploadTime(upload.key, gpuUploadMs, upload.bytes);
+        }
+
+        if (appState.sweepResolutions) {
+            std::chrono::duration<double> atResolution = frameEnd - appState.resolutionStart;
+            if (atResolution.count() >= kSweepSecondsPerResolution) {
+                if (appState.resolution + 1 < kResolutionCount) {
+                    setResolution(appState.resolution + 1);
+                } else {
+                    appState.sweepResolutions = false;
+                    printResolutionReport("RESOLUTION SCALING SWEEP");
+                }
+            }
+        }
 
         // Check if 60 seconds have elapsed for average FPS logging
         std::chrono::duration<double> elapsedTotal = frameEnd - appState.startTime;
         if (!appState.logged60SecAverage && elapsedTotal.count() >= 60.0) {
-            double totalFrameTime = 0;
-            for (double t : appState.allFrameTimes) totalFrameTime += t;
-            double avgFrameTime = totalFrameTime / appState.allFrameTimes.size();
-            double avgFPS = 1000.0 / avgFrameTime;
-            
-            cout << "\n========================================" << endl;
-            cout << "60-SECOND AVERAGE FPS REPORT" << endl;
-            cout << "========================================" << endl;
-            cout << "Mode: " << (appState.processingMode == GPU_MODE ? "GPU" : "CPU") << endl;
-            cout << "Filter: ";
-            switch (appState.currentFilter) {
-                case FILTER_NONE: cout << "None"; break;
-                case FILTER_PIXELATE: cout << "Pixelate"; break;
-                case FILTER_GRAYSCALE: cout << "Grayscale"; break;
-            }
-            cout << endl;
-            cout << "Average FPS: " << avgFPS << endl;
-            cout << "Average Frame Time: " << avgFrameTime << " ms" << endl;
-            cout << "Total Frames: " << appState.allFrameTimes.size() << endl;
-            cout << "========================================\n" << endl;
-            
+            printAverageFPSReport("60-SECOND AVERAGE FPS REPORT");
             appState.logged60SecAverage = true;
         }
 
         auto currentTime = std::chrono::high_resolution_clock::now();
         std::chrono::duration<double> elapsed = currentTime - lastTime;
         if (elapsed.count() >= 1.0) {
+            appState.sampleResident();
             double avgFrameTime = 0;
             for (double t : appState.frameTimes) avgFrameTime += t;
             avgFrameTime /= appState.frameTimes.size();
@@ -259,12 +669,8 @@ int main(void) {
 
             cout << "FPS: " << fps << " | Mode: "
                  << (appState.processingMode == GPU_MODE ? "GPU" : "CPU")
-                 << " | Filter: ";
-            switch (appState.currentFilter) {
-                case FILTER_NONE: cout << "None"; break;
-                case FILTER_PIXELATE: cout << "Pixelate"; break;
-                case FILTER_GRAYSCALE: cout << "Grayscale"; break;
-            }
+                 << " | Filter: " << filterName(appState.currentFilter)
+                 << " | " << appState.frameSize.width << "x" << appState.frameSize.height;
             cout << " | Elapsed: " << (int)elapsedTotal.count() << "s";
             if (!appState.logged60SecAverage) {
                 cout << " (60s report in " << (60 - (int)elapsedTotal.count()) << "s)";
@@ -277,17 +683,66 @@ int main(void) {
     }
 
     // --- Cleanup ---
+    if (options.headless && !appState.logged60SecAverage) printAverageFPSReport("HEADLESS RUN AVERAGE FPS REPORT");
     cout << "Closing application..." << endl;
+    Trace::dump("trace.json");
+    printAllocatorReport();
+    printResolutionReport("RESOLUTION SCALING REPORT");
     cap.release();
     delete myScene;
     delete renderingCamera;
     delete textureShader;
-    delete videoTexture;
+    delete blurPass;
+    delete temporalPass;
+    delete gpuHistory;
+    delete uploadTimer;
+    if (framePublisher) {
+        cout << "Published " << framePublisher->getFramesPublished() << " frames to shared memory" << endl;
+        delete framePublisher;
+        delete readback;
+        delete outputPass;
+    }
+    // Last: the passes and histories above render into pooled resources
+    delete resourcePool;
     glDeleteVertexArrays(1, &VertexArrayID);
-    glfwTerminate();
+#ifdef HAVE_EGL
+    delete offscreen;
+#endif
+    if (!options.headless) glfwTerminate();
+    frame.release();
+    setPooledAllocator(false);
     return 0;
 }
 
+// --- Frame Buffer Allocation ---
+void setPooledAllocator(bool enabled) {
+    // Mats already allocated keep a pointer to their allocator, so switching
+    // is safe at any time; the pool itself is never destroyed
+    cv::Mat::setDefaultAllocator(enabled ? &PooledMatAllocator::instance() : nullptr);
+    if (!enabled) PooledMatAllocator::instance().trim();
+}
+
+void printAllocatorReport() {
+    PooledMatAllocator::Stats stats = PooledMatAllocator::instance().getStats();
+    ProcessMemoryInfo memory = ProcessMemoryInfo::query();
+
+    cout << "Allocator: " << (appState.usePooledAllocator ? "Pooled" : "OpenCV default") << endl;
+    if (appState.usePooledAllocator) {
+        cout << "  Frame buffer allocations: " << stats.allocations
+             << " (pool hit rate " << stats.hitRate() * 100.0 << "%)" << endl;
+        cout << "  Small allocations: " << stats.smallAllocations << endl;
+        cout << "  Pool peak resident: " << stats.peakBytesResident / (1024.0 * 1024.0) << " MiB" << endl;
+    }
+    cout << "  Page faults: " << memory.pageFaults - appState.pageFaultsAtStart << endl;
+    cout << "  Process RSS: " << memory.residentBytes / (1024.0 * 1024.0) << " MiB";
+    if (appState.residentSamples > 0) {
+        cout << " (since reset: avg " << appState.residentSum / appState.residentSamples / (1024.0 * 1024.0)
+             << " MiB, max " << appState.residentMax / (1024.0 * 1024.0) << " MiB)";
+    }
+    cout << endl;
+    cout << "  Process peak RSS (lifetime): " << memory.peakResidentBytes / (1024.0 * 1024.0) << " MiB" << endl;
+}
+
 // --- CPU Filter Implementations ---
 void applyPixelationCPU(cv::Mat& frame, int pixelSize) {
     for (int y = 0; y < frame.rows; y += pixelSize) {
@@ -304,6 +759,244 @@ void applyGrayscaleCPU(cv::Mat& frame) {
     cv::cvtColor(frame, frame, cv::COLOR_GRAY2BGR);
 }
 
+void printAverageFPSReport(const char* title) {
+    if (appState.allFrameTimes.empty()) return;
+
+    double totalFrameTime = 0;
+    for (double t : appState.allFrameTimes) totalFrameTime += t;
+    double avgFrameTime = totalFrameTime / appState.allFrameTimes.size();
+    double avgFPS = 1000.0 / avgFrameTime;
+    
+    cout << "\n========================================" << endl;
+    cout << title << endl;
+    cout << "========================================" << endl;
+    cout << "Mode: " << (appState.processingMode == GPU_MODE ? "GPU" : "CPU") << endl;
+    cout << "Filter: " << filterName(appState.currentFilter) << endl;
+    cout << "Average FPS: " << avgFPS << endl;
+    cout << "Average Frame Time: " << avgFrameTime << " ms" << endl;
+    cout << "Total Frames: " << appState.allFrameTimes.size() << endl;
+    printAllocatorReport();
+    cout << "========================================\n" << endl;
+}
+
+const char* filterName(FilterMode mode) {
+    switch (mode) {
+        case FILTER_PIXELATE: return "Pixelate";
+        case FILTER_GRAYSCALE: return "Grayscale";
+        case FILTER_BOX_BLUR: return "Box Blur";
+        case FILTER_GAUSSIAN_BLUR: return "Gaussian Blur";
+        case FILTER_TEMPORAL_DENOISE: return "Temporal Denoise";
+        case FILTER_MOTION_MASK: return "Motion Mask";
+        case FILTER_EMA: return "EMA";
+        default: return "None";
+    }
+}
+
+bool isTemporalFilter(FilterMode mode) {
+    return mode == FILTER_TEMPORAL_DENOISE || mode == FILTER_MOTION_MASK || mode == FILTER_EMA;
+}
+
+TemporalOperation temporalOperation(FilterMode mode) {
+    switch (mode) {
+        case FILTER_MOTION_MASK: return TEMPORAL_MOTION_MASK;
+        case FILTER_EMA: return TEMPORAL_EMA;
+        default: return TEMPORAL_DENOISE;
+    }
+}
+
+// --- Resolution Switching ---
+int findResolution(const std::string& name) {
+    for (int i = 0; i < kResolutionCount; i++) {
+        if (name == kResolutions[i].name) return i;
+    }
+    return -1;
+}
+
+// Preset height, width scaled by the source aspect ratio and rounded to an
+// even number of pixels
+cv::Size presetSize(const ResolutionPreset& preset, const cv::Size& source) {
+    if (source.height == preset.height) return source;
+    int width = (int)std::lround((double)source.width * preset.height / source.height / 2.0) * 2;
+    return cv::Size(std::max(width, 2), preset.height);
+}
+
+void setResolution(int index) {
+    appState.resolution = index;
+    appState.resolutionChanged = true;
+}
+
+// Starts the sweep from the first preset, replacing the current filter and
+// mode's curve; curves of other filters and modes stay in the report
+void restartResolutionSweep() {
+    for (auto it = appState.resolutionStats.begin(); it != appState.resolutionStats.end();) {
+        bool current = std::get<0>(it->first) == (int)appState.currentFilter &&
+                       std::get<1>(it->first) == (int)appState.processingMode;
+        it = current ? appState.resolutionStats.erase(it) : std::next(it);
+    }
+    appState.sweepResolutions = true;
+    setResolution(0);
+}
+
+void applyResolution(cv::VideoCapture& cap, bool camera) {
+    appState.resolutionChanged = false;
+    appState.resolutionStart = std::chrono::high_resolution_clock::now();
+    if (appState.resolution < 0) return;
+
+    const ResolutionPreset& preset = kResolutions[appState.resolution];
+    if (appState.framesAtSize > 0) printResolutionSummary(appState.statsKey);
+    if (camera) {
+        // Frames are resized to the preset if the camera picks a different mode
+        cap.set(cv::CAP_PROP_FRAME_WIDTH, preset.width);
+        cap.set(cv::CAP_PROP_FRAME_HEIGHT, preset.height);
+    }
+    appState.resetFPSTracking();
+    cout << "Resolution: " << preset.name << " (height " << preset.height
+         << ", width follows the source aspect ratio) (FPS tracking reset)" << endl;
+}
+
+// Returns false for warm-up frames, which are not counted
+bool recordResolutionFrame(const cv::Size& size, double frameMs, double copyMs) {
+    AppState::ResolutionKey key((int)appState.currentFilter, (int)appState.processingMode,
+                                size.width, size.height);
+    if (key != appState.statsKey) {
+        appState.statsKey = key;
+        appState.frameSize = size;
+        appState.framesAtSize = 0;
+    }
+    // Skip the frames that pay for pool misses, camera reconfiguration and
+    // refilling the frame history
+    if (++appState.framesAtSize <= kResolutionWarmupFrames) return false;
+
+    AppState::ResolutionStats& stats = appState.resolutionStats[key];
+    stats.frames++;
+    stats.frameMs += frameMs;
+    stats.copyMs += copyMs;
+    return true;
+}
+
+void recordUploadTime(const AppState::ResolutionKey& key, double gpuMs, uint64_t bytes) {
+    AppState::ResolutionStats& stats = appState.resolutionStats[key];
+    stats.gpuUploads++;
+    stats.gpuUploadMs += gpuMs;
+    stats.gpuUploadBytes += bytes;
+}
+
+// Bytes moved per second of GPU upload time, in MB/s
+double uploadBandwidth(const AppState::ResolutionStats& stats) {
+    if (stats.gpuUploadMs <= 0.0) return 0.0;
+    return stats.gpuUploadBytes / (stats.gpuUploadMs / 1000.0) / (1024.0 * 1024.0);
+}
+
+void printResolutionSummary(const AppState::ResolutionKey& key) {
+    auto found = appState.resolutionStats.find(key);
+    if (found == appState.resolutionStats.end() || found->second.frames == 0) return;
+
+    const AppState::ResolutionStats& stats = found->second;
+    printf("%s %s %dx%d: %.1f FPS, copy %.3f ms/frame, GPU upload %.3f ms/frame (%.1f MB/s) over %llu frames\n",
+           std::get<1>(key) == GPU_MODE ? "GPU" : "CPU", filterName((FilterMode)std::get<0>(key)),
+           std::get<2>(key), std::get<3>(key), 1000.0 * stats.frames / stats.frameMs, stats.copyMs / stats.frames,
+           stats.gpuUploads ? stats.gpuUploadMs / stats.gpuUploads : 0.0, uploadBandwidth(stats),
+           (unsigned long long)stats.frames);
+}
+
+void printResolutionReport(const char* title) {
+    if (appState.resolutionStats.empty()) return;
+
+    cout << "\n========================================" << endl;
+    cout << title << endl;
+    cout << "========================================" << endl;
+    cout << "Mode | Filter           | Resolution  |    FPS | Frame ms | Copy ms | GPU upload ms | Upload MB/s | Frames"
+         << endl;
+
+    FILE* csv = fopen("resolution_scaling.csv", "w");
+    if (csv) fprintf(csv, "mode,filter,width,height,fps,frame_ms,copy_ms,gpu_upload_ms,upload_mb_per_s,frames\n");
+
+    for (const auto& entry : appState.resolutionStats) {
+        const char* mode = std::get<1>(entry.first) == GPU_MODE ? "GPU" : "CPU";
+        const char* filter = filterName((FilterMode)std::get<0>(entry.first));
+        int width = std::get<2>(entry.first);
+        int height = std::get<3>(entry.first);
+        const AppState::ResolutionStats& stats = entry.second;
+        if (stats.frames == 0) continue;
+        double frameMs = stats.frameMs / stats.frames;
+        double copyMs = stats.copyMs / stats.frames;
+        double gpuUploadMs = stats.gpuUploads ? stats.gpuUploadMs / stats.gpuUploads : 0.0;
+        double uploadMBps = uploadBandwidth(stats);
+        printf("%-4s | %-16s | %4dx%-6d | %6.1f | %8.3f | %7.3f | %13.3f | %11.1f | %llu\n", mode, filter,
+               width, height, 1000.0 / frameMs, frameMs, copyMs, gpuUploadMs, uploadMBps,
+               (unsigned long long)stats.frames);
+        if (csv) {
+            fprintf(csv, "%s,%s,%d,%d,%.2f,%.4f,%.4f,%.4f,%.1f,%llu\n", mode, filter, width, height,
+                    1000.0 / frameMs, frameMs, copyMs, gpuUploadMs, uploadMBps, (unsigned long long)stats.frames);
+        }
+    }
+
+    if (csv) {
+        fclose(csv);
+        cout << "Results written to resolution_scaling.csv" << endl;
+    }
+    cout << "========================================\n" << endl;
+}
+
+// --- Blur Benchmark ---
+// Times box and Gaussian blur at every radius from 1 to 64 on both paths.
+// GPU times come from timer queries, so they measure the passes themselves.
+void runBlurBenchmark(const cv::Mat& frame, Texture* sourceTexture, BlurPass* blurPass) {
+    const int iterations = 10;
+    const int maxRadius = 64;
+
+    cout << "\n========================================" << endl;
+    cout << "BLUR RADIUS BENCHMARK (" << frame.cols << "x" << frame.rows
+         << ", " << iterations << " iterations)" << endl;
+    cout << "========================================" << endl;
+    cout << "Radius | CPU Box ms | CPU Gauss ms | GPU Box ms | GPU Gauss ms" << endl;
+
+    FILE* csv = fopen("blur_benchmark.csv", "w");
+    if (csv) fprintf(csv, "radius,cpu_box_ms,cpu_gaussian_ms,gpu_box_ms,gpu_gaussian_ms\n");
+
+    GLuint query;
+    glGenQueries(1, &query);
+    cv::Mat work(frame.size(), frame.type());
+    cv::Mat scratch(frame.size(), frame.type());
+
+    for (int radius = 1; radius <= maxRadius; radius++) {
+        double cpuMs[2] = { 0.0, 0.0 };
+        double gpuMs[2] = { 0.0, 0.0 };
+
+        for (int kind = 0; kind < 2; kind++) {
+            bool gaussian = kind == 1;
+            for (int i = 0; i < iterations; i++) {
+                frame.copyTo(work);
+                auto start = std::chrono::high_resolution_clock::now();
+                if (gaussian) applyGaussianBlurCPU(work, radius, scratch);
+                else applyBoxBlurCPU(work, radius, scratch);
+                auto end = std::chrono::high_resolution_clock::now();
+                cpuMs[kind] += std::chrono::duration<double, std::milli>(end - start).count();
+
+                glBeginQuery(GL_TIME_ELAPSED, query);
+                blurPass->apply(sourceTexture, frame.cols, frame.rows, radius, gaussian);
+                glEndQuery(GL_TIME_ELAPSED);
+                GLuint64 elapsedNs = 0;
+                glGetQueryObjectui64v(query, GL_QUERY_RESULT, &elapsedNs);
+                gpuMs[kind] += elapsedNs / 1.0e6;
+            }
+            cpuMs[kind] /= iterations;
+            gpuMs[kind] /= iterations;
+        }
+
+        printf("%6d | %10.3f | %12.3f | %10.3f | %12.3f\n",
+               radius, cpuMs[0], cpuMs[1], gpuMs[0], gpuMs[1]);
+        if (csv) fprintf(csv, "%d,%.4f,%.4f,%.4f,%.4f\n", radius, cpuMs[0], cpuMs[1], gpuMs[0], gpuMs[1]);
+    }
+
+    glDeleteQueries(1, &query);
+    if (csv) {
+        fclose(csv);
+        cout << "Results written to blur_benchmark.csv" << endl;
+    }
+    cout << "========================================\n" << endl;
+}
+
 // --- Input Callbacks ---
 void keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods) {
     if (action == GLFW_PRESS) {
@@ -324,6 +1017,34 @@ void keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods
                 appState.resetFPSTracking();
                 cout << "Filter: Grayscale (FPS tracking reset)\n"; 
                 break;
+            case GLFW_KEY_4:
+                appState.currentFilter = FILTER_BOX_BLUR;
+                appState.resetFPSTracking();
+                cout << "Filter: Box Blur, radius " << appState.blurRadius << " (FPS tracking reset)\n";
+                break;
+            case GLFW_KEY_5:
+                appState.currentFilter = FILTER_GAUSSIAN_BLUR;
+                appState.resetFPSTracking();
+                cout << "Filter: Gaussian Blur, radius " << appState.blurRadius << " (FPS tracking reset)\n";
+                break;
+            case GLFW_KEY_6:
+            case GLFW_KEY_7:
+            case GLFW_KEY_8:
+                appState.currentFilter = (FilterMode)(FILTER_TEMPORAL_DENOISE + (key - GLFW_KEY_6));
+                appState.resetFPSTracking();
+                cout << "Filter: " << filterName(appState.currentFilter)
+                     << ", " << kHistoryFrames << " frame history (FPS tracking reset)\n";
+                break;
+            case GLFW_KEY_LEFT_BRACKET:
+            case GLFW_KEY_RIGHT_BRACKET:
+                appState.blurRadius += (key == GLFW_KEY_RIGHT_BRACKET) ? 1 : -1;
+                appState.blurRadius = glm::clamp(appState.blurRadius, 1, 64);
+                appState.resetFPSTracking();
+                cout << "Blur radius: " << appState.blurRadius << " (FPS tracking reset)\n";
+                break;
+            case GLFW_KEY_B:
+                appState.runBlurBenchmark = true;
+                break;
             case GLFW_KEY_C:
                 appState.processingMode =
                     (appState.processingMode == GPU_MODE) ? CPU_MODE : GPU_MODE;
@@ -331,6 +1052,30 @@ void keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods
                 cout << "Mode: " << (appState.processingMode == GPU_MODE ? "GPU" : "CPU") 
                      << " (FPS tracking reset)" << endl;
                 break;
+#ifdef ENABLE_TRACING
+            case GLFW_KEY_T:
+                Trace::dump("trace.json");
+                break;
+#endif
+            case GLFW_KEY_P:
+                appState.usePooledAllocator = !appState.usePooledAllocator;
+                setPooledAllocator(appState.usePooledAllocator);
+                appState.resetFPSTracking();
+                cout << "Allocator: " << (appState.usePooledAllocator ? "Pooled" : "OpenCV default")
+                     << " (FPS tracking reset)" << endl;
+                break;
+            case GLFW_KEY_F1:
+            case GLFW_KEY_F2:
+            case GLFW_KEY_F3:
+            case GLFW_KEY_F4:
+                appState.sweepResolutions = false;
+                setResolution(key - GLFW_KEY_F1);
+                break;
+            case GLFW_KEY_V:
+                restartResolutionSweep();
+                cout << "Sweeping " << kResolutionCount << " resolutions, "
+                     << kSweepSecondsPerResolution << "s each" << endl;
+                break;
             case GLFW_KEY_SPACE:
                 appState.translation = glm::vec2(0.0f);
                 appState.rotation = 0.0f;
@@ -377,6 +1122,58 @@ void scrollCallback(GLFWwindow* window, double xoffset, double yoffset) {
     appState.scale = glm::clamp(appState.scale, 0.1f, 5.0f);
 }
 
+// --- Command Line ---
+bool parseArguments(int argc, char** argv, LaunchOptions& options) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (arg == "--input" && hasValue) {
+            options.inputPath = argv[++i];
+        } else if (arg == "--headless") {
+            options.headless = true;
+        } else if (arg == "--frames" && hasValue) {
+            options.headlessFrames = std::max(1, atoi(argv[++i]));
+        } else if (arg == "--shm" && hasValue) {
+            options.shmName = argv[++i];
+        } else if (arg == "--shm-slots" && hasValue) {
+            options.shmSlots = std::max(2, atoi(argv[++i]));
+        } else if (arg == "--resolution" && hasValue) {
+            options.resolution = findResolution(argv[++i]);
+            if (options.resolution < 0) {
+                cerr << "Unknown resolution: " << argv[i] << " (480p, 720p, 1080p or 4K)" << endl;
+                return false;
+            }
+        } else if (arg == "--sweep-resolutions") {
+            options.sweepResolutions = true;
+        } else if (arg == "--cpu") {
+            appState.processingMode = CPU_MODE;
+        } else if (arg == "--no-pool") {
+            appState.usePooledAllocator = false;
+        } else if (arg == "--filter" && hasValue) {
+            int filter = atoi(argv[++i]);
+            if (filter < 1 || filter > FILTER_EMA + 1) {
+                cerr << "Unknown filter: " << filter << endl;
+                return false;
+            }
+            appState.currentFilter = (FilterMode)(filter - 1);
+        } else {
+            cerr << "Usage: " << argv[0] << " [--input <video file>] [--cpu] [--no-pool] [--filter <1-8>]"
+                 << " [--headless [--frames <count>]] [--shm <name> [--shm-slots <n>]]"
+                 << " [--resolution <480p|720p|1080p|4K>] [--sweep-resolutions]" << endl;
+            return false;
+        }
+    }
+
+#ifndef HAVE_EGL
+    if (options.headless) {
+        cerr << "Error: --headless needs EGL support (configure with ENABLE_HEADLESS on Linux)." << endl;
+        return false;
+    }
+#endif
+    return true;
+}
+
 // --- Window Initialization ---
 bool initWindow(std::string windowName) {
     if (!glfwInit()) {
@@ -390,7 +1187,7 @@ bool initWindow(std::string windowName) {
     glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
 
-    window = glfwCreateWindow(1024, 768, windowName.c_str(), NULL, NULL);
+    window = glfwCreateWindow(kWindowWidth, kWindowHeight, windowName.c_str(), NULL, NULL);
     if (window == NULL) {
         fprintf(stderr, "Failed to open GLFW window.\n");
         glfwTerminate();
@@ -0,0 +1,46 @@
+#version 330 core
+
+// Input from vertex shader
+in vec2 UV;
+
+// Output color
+out vec3 color;
+
+// Texture sampler (must use linear filtering)
+uniform sampler2D textureSampler;
+
+// Blur parameters
+uniform vec2 uDirection;   // one texel along the blur axis
+uniform int uRadius;
+uniform int uGaussian;     // 0=box, 1=gaussian
+uniform float uSigma;
+
+float tapWeight(int i) {
+    if (uGaussian == 1) {
+        return exp(-0.5 * float(i * i) / (uSigma * uSigma));
+    }
+    return 1.0;
+}
+
+void main() {
+    float centerWeight = tapWeight(0);
+    vec3 sum = texture(textureSampler, UV).rgb * centerWeight;
+    float totalWeight = centerWeight;
+
+    // Linear sampling: texels i and i+1 are read with a single bilinear fetch
+    // placed between them at the ratio of their weights
+    for (int i = 1; i <= uRadius; i += 2) {
+        float w1 = tapWeight(i);
+        float w2 = (i + 1 <= uRadius) ? tapWeight(i + 1) : 0.0;
+        float w = w1 + w2;
+        if (w <= 0.0) break;
+
+        float offset = (float(i) * w1 + float(i + 1) * w2) / w;
+        vec2 delta = uDirection * offset;
+        sum += (texture(textureSampler, UV + delta).rgb +
+                texture(textureSampler, UV - delta).rgb) * w;
+        totalWeight += 2.0 * w;
+    }
+
+    color = sum / totalWeight;
+}
@@ -0,0 +1,16 @@
+#version 330 core
+
+// Clip-space position of the fullscreen quad
+layout(location = 0) in vec2 position;
+
+// Output data for fragment shader
+out vec2 UV;
+
+// Sample the source upside down (for passes that are read back)
+uniform int uFlipY;
+
+void main() {
+    UV = position * 0.5 + 0.5;
+    if (uFlipY != 0) UV.y = 1.0 - UV.y;
+    gl_Position = vec4(position, 0.0, 1.0);
+}
@@ -0,0 +1,60 @@
+#version 330 core
+
+// Output color
+out vec3 color;
+
+// Ring of past frames, one per layer
+uniform sampler2DArray historySampler;
+uniform int uLayers;
+uniform int uCount;        // number of valid layers
+uniform int uNewest;       // layer holding the newest frame
+
+// Previous EMA result, same size as the output
+uniform sampler2D accumulatorSampler;
+uniform int uRestart;      // non-zero: start the EMA again from the newest frame
+
+// Operation parameters
+uniform int uOperation;    // 0=denoise, 1=motion mask, 2=exponential moving average
+uniform float uAlpha;
+uniform float uThreshold;
+
+// Frame from 'age' frames ago (0 = newest); output and history are the same size
+vec3 historyFrame(int age) {
+    int layer = (uNewest - age + uLayers) % uLayers;
+    return texelFetch(historySampler, ivec3(ivec2(gl_FragCoord.xy), layer), 0).rgb;
+}
+
+// Temporal denoise: plain average of every stored frame
+vec3 applyDenoise() {
+    vec3 sum = vec3(0.0);
+    for (int age = 0; age < uCount; age++) {
+        sum += historyFrame(age);
+    }
+    return sum / float(uCount);
+}
+
+// Frame differencing: white where the luma changed more than the threshold
+vec3 applyMotionMask() {
+    if (uCount < 2) return vec3(0.0);
+    vec3 diff = abs(historyFrame(0) - historyFrame(1));
+    float luma = dot(diff, vec3(0.299, 0.587, 0.114));
+    return vec3(luma > uThreshold ? 1.0 : 0.0);
+}
+
+// Exponential moving average: blend the newest frame into the accumulator
+vec3 applyEMA() {
+    vec3 newest = historyFrame(0);
+    if (uRestart != 0) return newest;
+    vec3 previous = texelFetch(accumulatorSampler, ivec2(gl_FragCoord.xy), 0).rgb;
+    return mix(previous, newest, uAlpha);
+}
+
+void main() {
+    if (uOperation == 1) {
+        color = applyMotionMask();
+    } else if (uOperation == 2) {
+        color = applyEMA();
+    } else {
+        color = applyDenoise();
+    }
+}
@@ -0,0 +1,203 @@
+/*
+ * Reference consumer for the shared-memory frame ring
+ *
+ * USAGE:
+ *   ShmConsumer [name] [--slow <ms>]
+ *       Attaches to the ring published by VideoProcessing --shm <name>
+ *       (default "vp_frames") and reports received frames, drops, torn
+ *       reads, latency and throughput once per second. --slow adds a delay
+ *       per frame to show that a slow reader only loses frames. If no frame
+ *       arrives for a second the ring is re-opened by name, so the consumer
+ *       follows a restarted publisher.
+ *
+ *   ShmConsumer --bench [--width <w>] [--height <h>] [--seconds <s>] [--slots <n>]
+ *       Runs a publisher and a reader thread on a private ring and prints
+ *       publish cost, end-to-end latency percentiles and throughput.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <common/SharedFrameRing.hpp>
+
+using namespace std;
+
+const chrono::seconds kReattachTimeout(1);
+
+struct ReaderStats {
+    uint64_t frames = 0;
+    uint64_t dropped = 0;      // frames published but never seen
+    uint64_t torn = 0;         // overwritten while being read
+    uint64_t bytes = 0;
+    uint64_t checksum = 0;
+    vector<double> latenciesUs;
+
+    void reset() { *this = ReaderStats(); }
+};
+
+// Reads the frame in place (a stand-in for real analytics) and validates it
+bool consumeFrame(SharedFrameReader& reader, const SharedFrameReader::FrameView& view,
+                  uint64_t& lastFrame, ReaderStats& stats) {
+    double latencyUs = (SharedFrameRing::nowNs() - view.timestampNs) / 1000.0;
+
+    uint64_t sum = 0;
+    for (uint32_t i = 0; i < view.bytes; i += 64) sum += view.data[i];
+
+    if (!reader.validate(view)) {
+        stats.torn++;
+        return false;
+    }
+    if (lastFrame && view.frameNumber > lastFrame + 1) stats.dropped += view.frameNumber - lastFrame - 1;
+    lastFrame = view.frameNumber;
+
+    stats.frames++;
+    stats.bytes += view.bytes;
+    stats.checksum += sum;
+    stats.latenciesUs.push_back(latencyUs);
+    return true;
+}
+
+double percentile(vector<double>& values, double p) {
+    if (values.empty()) return 0.0;
+    size_t index = min(values.size() - 1, (size_t)(p * (values.size() - 1) + 0.5));
+    nth_element(values.begin(), values.begin() + index, values.end());
+    return values[index];
+}
+
+void printStats(ReaderStats& stats, double seconds) {
+    printf("frames: %6.1f/s | dropped: %llu | torn: %llu | %8.1f MB/s | latency us p50 %.1f p99 %.1f max %.1f\n",
+           stats.frames / seconds, (unsigned long long)stats.dropped, (unsigned long long)stats.torn,
+           stats.bytes / seconds / (1024.0 * 1024.0),
+           percentile(stats.latenciesUs, 0.50), percentile(stats.latenciesUs, 0.99),
+           percentile(stats.latenciesUs, 1.0));
+    fflush(stdout);
+}
+
+int runConsumer(const string& name, int slowMs) {
+    SharedFrameReader reader;
+    printf("Waiting for ring '%s'...\n", name.c_str());
+    while (!reader.open(name)) this_thread::sleep_for(chrono::milliseconds(200));
+    printf("Attached to '%s'\n", name.c_str());
+
+    ReaderStats stats;
+    uint64_t lastFrame = 0;
+    auto windowStart = chrono::steady_clock::now();
+    SharedFrameReader::FrameView view;
+    bool printedFormat = false;
+    auto lastActivity = chrono::steady_clock::now();
+
+    while (true) {
+        if (reader.acquireLatest(view)) {
+            lastActivity = chrono::steady_clock::now();
+            if (!printedFormat) {
+                printedFormat = true;
+                printf("Format %u, %ux%u, stride %u%s\n", view.format, view.width, view.height,
+                       view.stride, (view.flags & SHARED_FRAME_BOTTOM_UP) ? ", bottom-up" : "");
+            }
+            consumeFrame(reader, view, lastFrame, stats);
+            if (slowMs > 0) this_thread::sleep_for(chrono::milliseconds(slowMs));
+        } else {
+            this_thread::sleep_for(chrono::microseconds(100));
+        }
+
+        auto now = chrono::steady_clock::now();
+        if (now - lastActivity >= kReattachTimeout) {
+            // Quiet ring: the publisher may have restarted under the same name
+            lastActivity = now;
+            if (reader.reattachIfReplaced()) {
+                printf("Ring '%s' was recreated, re-attached\n", name.c_str());
+                lastFrame = 0;
+                printedFormat = false;
+            }
+        }
+        double elapsed = chrono::duration<double>(now - windowStart).count();
+        if (elapsed >= 1.0) {
+            printStats(stats, elapsed);
+            stats.reset();
+            windowStart = now;
+        }
+    }
+}
+
+int runBenchmark(uint32_t width, uint32_t height, double seconds, uint32_t slots) {
+    const uint32_t stride = width * 3;
+    const uint32_t frameBytes = stride * height;
+    string name = "vp_bench_" + to_string((long long)SharedFrameRing::nowNs());
+
+    SharedFramePublisher publisher;
+    if (!publisher.open(name, slots, frameBytes)) return -1;
+
+    vector<unsigned char> frame(frameBytes);
+    for (size_t i = 0; i < frame.size(); i++) frame[i] = (unsigned char)(i * 31);
+
+    atomic<bool> running(true);
+    ReaderStats stats;
+    thread readerThread([&]() {
+        SharedFrameReader reader;
+        if (!reader.open(name)) return;
+        uint64_t lastFrame = 0;
+        SharedFrameReader::FrameView view;
+        while (running.load()) {
+            if (reader.acquireLatest(view)) consumeFrame(reader, view, lastFrame, stats);
+        }
+    });
+
+    printf("Publishing %ux%u BGR8 frames (%.2f MB) into %u slots for %.0f s...\n",
+           width, height, frameBytes / (1024.0 * 1024.0), slots, seconds);
+
+    vector<double> publishUs;
+    auto start = chrono::steady_clock::now();
+    while (chrono::duration<double>(chrono::steady_clock::now() - start).count() < seconds) {
+        auto t0 = chrono::steady_clock::now();
+        publisher.publish(frame.data(), width, height, stride, SHARED_FRAME_BGR8);
+        publishUs.push_back(chrono::duration<double, micro>(chrono::steady_clock::now() - t0).count());
+    }
+    double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    running.store(false);
+    readerThread.join();
+
+    printf("\n========================================\n");
+    printf("SHARED MEMORY RING BENCHMARK\n");
+    printf("========================================\n");
+    printf("Published: %llu frames, %.1f frames/s, %.1f MB/s\n",
+           (unsigned long long)publisher.getFramesPublished(), publisher.getFramesPublished() / elapsed,
+           publisher.getFramesPublished() * (double)frameBytes / elapsed / (1024.0 * 1024.0));
+    printf("Publish cost: p50 %.1f us, p99 %.1f us\n", percentile(publishUs, 0.50), percentile(publishUs, 0.99));
+    printf("Reader: ");
+    printStats(stats, elapsed);
+    printf("========================================\n");
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    string name = "vp_frames";
+    bool bench = false;
+    int slowMs = 0;
+    uint32_t width = 1280, height = 720, slots = 4;
+    double seconds = 5.0;
+
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--bench") bench = true;
+        else if (arg == "--slow" && hasValue) slowMs = atoi(argv[++i]);
+        else if (arg == "--width" && hasValue) width = (uint32_t)atoi(argv[++i]);
+        else if (arg == "--height" && hasValue) height = (uint32_t)atoi(argv[++i]);
+        else if (arg == "--seconds" && hasValue) seconds = atof(argv[++i]);
+        else if (arg == "--slots" && hasValue) slots = (uint32_t)max(1, atoi(argv[++i]));
+        else if (arg[0] != '-') name = arg;
+        else {
+            fprintf(stderr, "Usage: %s [name] [--slow <ms>] | --bench [--width <w>] [--height <h>]"
+                            " [--seconds <s>] [--slots <n>]\n", argv[0]);
+            return -1;
+        }
+    }
+
+    return bench ? runBenchmark(width, height, seconds, slots) : runConsumer(name, slowMs);
+}